@@ -1,3 +1,9 @@
+#ifndef ALGO_HPP
+#define ALGO_HPP
+
+#include "../old/big_numbers/arena.hpp"
+#include "generic_algorithms.hpp"
+
 #include <boost/integer.hpp>
 #include <boost/multiprecision/cpp_int.hpp>
 #include <boost/random.hpp>
@@ -7,154 +13,149 @@
 
 using boost::multiprecision::cpp_int;
 
-using BigNumber = cpp_int;
+// Коэффициенты берутся через ArenaAllocator: внутри тестов простоты временные числа не обращаются к куче
+using BigNumber = boost::multiprecision::number<
+    boost::multiprecision::cpp_int_backend<0, 0, boost::multiprecision::signed_magnitude,
+                                           boost::multiprecision::unchecked,
+                                           big_number::ArenaAllocator<boost::multiprecision::limb_type>>>;
 using PrimeFactors = std::vector<std::pair<BigNumber, BigNumber>>;
 
 BigNumber Generator(const BigNumber &min, const BigNumber &max)
 {
-    static boost::random::random_device rd;
-    static boost::random::mt19937_64 rng(rd());
+    // Генератор свой у каждого потока: параллельные тесты простоты не делят состояние
+    static thread_local boost::random::random_device rd;
+    static thread_local boost::random::mt19937_64 rng(rd());
 
-    boost::random::uniform_int_distribution<cpp_int> dist(min, max);
+    boost::random::uniform_int_distribution<BigNumber> dist(min, max);
     return dist(rng);
 }
 
-BigNumber PowMod(BigNumber number, BigNumber exp, const BigNumber &mod)
+BigNumber PowMod(const BigNumber &number, const BigNumber &exp, const BigNumber &mod)
 {
-    BigNumber result = 1;
-    BigNumber base = number % mod; // Уменьшаем base по модулю, чтобы работать с меньшими числами
-
-    while (exp > 0)
-    {
-        if (exp % 2 == 1)
-            result = (result * base) % mod;
-        base = (base * base) % mod;
-        exp /= 2;
-    }
-    return result;
+    return generic::PowMod(BigNumber(number % mod), exp, mod);
 }
 
-BigNumber JacobiNumbers(const BigNumber &a, const BigNumber &n)
+// Обратный элемент по модулю: расширенный алгоритм Лемера.
+// Пока числа длинные, частные восстанавливаются по старшим 62 битам в машинных
+// словах (алгоритм L Кнута), и к полным числам применяется только накопленная
+// матрица 2x2. Полное деление выполняется лишь когда слова не дают ни одного шага.
+BigNumber ModInverse(const BigNumber &a, const BigNumber &mod)
 {
-    if (a == 0)
-    {
-        return 0;
-    }
-    if (a == 1)
-    {
-        return 1;
-    }
-    BigNumber k = 0;
-    BigNumber a1 = a;
+    if (mod < 2)
+        throw std::invalid_argument("Модуль должен быть больше 1");
 
-    while (a1 % 2 == 0)
-    {
-        a1 = a1 / 2;
-        k = k + 1;
-    }
+    BigNumber r0 = mod;
+    BigNumber r1 = a % mod;
+    if (r1 < 0)
+        r1 += mod;
+    BigNumber t0 = 0; // r0 = t0 * a (mod m)
+    BigNumber t1 = 1; // r1 = t1 * a (mod m)
 
-    BigNumber s;
-    if (k % 2 == 0)
-    {
-        s = 1;
-    }
-    else
+    while (r1 != 0)
     {
-        BigNumber n_mod8 = n % 8;
-        if (n_mod8 == 1 || n_mod8 == 7)
+        const unsigned bits = static_cast<unsigned>(msb(r0)) + 1;
+        long long A = 1, B = 0, C = 0, D = 1;
+        if (bits > 62)
+        {
+            const unsigned shift = bits - 62;
+            long long x = static_cast<long long>(r0 >> shift);
+            long long y = static_cast<long long>(r1 >> shift);
+            while (y + C != 0 && y + D != 0)
+            {
+                const long long q = (x + A) / (y + C);
+                if (q != (x + B) / (y + D))
+                    break;
+                long long temp = A - q * C;
+                A = C;
+                C = temp;
+                temp = B - q * D;
+                B = D;
+                D = temp;
+                temp = x - q * y;
+                x = y;
+                y = temp;
+            }
+        }
+
+        if (B == 0)
         {
-            s = 1;
+            // Обычный шаг Евклида на полных числах
+            BigNumber q = r0 / r1;
+            BigNumber temp = r0 - q * r1;
+            r0 = r1;
+            r1 = temp;
+            temp = t0 - q * t1;
+            t0 = t1;
+            t1 = temp;
         }
         else
         {
-            s = -1;
+            BigNumber newR0 = A * r0 + B * r1;
+            r1 = C * r0 + D * r1;
+            r0 = newR0;
+            BigNumber newT0 = A * t0 + B * t1;
+            t1 = C * t0 + D * t1;
+            t0 = newT0;
         }
     }
-    if (n % 4 == 3 && a1 % 4 == 3)
-    {
-        s = -s;
-    }
-    if (a1 == 1)
-    {
-        return s;
-    }
-    else
+
+    if (r0 != 1)
+        throw std::invalid_argument("Элемент необратим по модулю");
+    t0 %= mod;
+    return t0 < 0 ? t0 + mod : t0;
+}
+
+// Пакетное обращение приемом Монтгомери: одно обращение и 3(N-1) умножений
+std::vector<BigNumber> BatchModInverse(const std::vector<BigNumber> &values, const BigNumber &mod)
+{
+    std::vector<BigNumber> result(values.size());
+    if (values.empty())
+        return result;
+
+    // prefix[i] = values[0] * ... * values[i] mod m
+    std::vector<BigNumber> prefix(values.size());
+    prefix[0] = values[0] % mod;
+    for (size_t i = 1; i < values.size(); ++i)
+        prefix[i] = (prefix[i - 1] * values[i]) % mod;
+
+    BigNumber inverse = ModInverse(prefix.back(), mod);
+    for (size_t i = values.size() - 1; i > 0; --i)
     {
-        return s * JacobiNumbers(n % a1, a1);
+        result[i] = (inverse * prefix[i - 1]) % mod;
+        inverse = (inverse * values[i]) % mod;
     }
-};
+    result[0] = inverse;
+
+    for (auto &value : result)
+        if (value < 0)
+            value += mod;
+    return result;
+}
+
+BigNumber JacobiNumbers(const BigNumber &a, const BigNumber &n)
+{
+    return generic::Jacobi(a, n);
+}
 
 bool FermatTest(const BigNumber &number, size_t reliabilityParameter)
 {
     if (number < 4)
         throw std::invalid_argument("Число должно быть больше 3");
-
-    for (size_t i = 0; i < reliabilityParameter; ++i)
-    {
-        auto randBN = Generator(2, number - 2);
-        if (PowMod(randBN, number - 1, number) != 1)
-            return false;
-    }
-    return true;
+    return generic::FermatTest(number, reliabilityParameter);
 }
 
 bool MillerRabinTest(const BigNumber &number, size_t reliabilityParameter)
 {
     if (number < 4)
         throw std::invalid_argument("Число должно быть больше 3");
-
-    BigNumber d = number - 1;
-    BigNumber s = 0;
-
-    while (d % 2 == 0)
-    {
-        d /= 2;
-        s += 1;
-    }
-
-    for (size_t i = 0; i < reliabilityParameter; ++i)
-    {
-        auto randBN = Generator(2, number - 2);
-        BigNumber x = PowMod(randBN, d, number);
-
-        if (x == 1 || x == number - 1)
-            continue;
-
-        for (BigNumber j = 1; j < s; ++j)
-        {
-            x = PowMod(x, 2, number);
-            if (x == number - 1)
-                break;
-            if (x == 1)
-                return false;
-        }
-
-        if (x != number - 1)
-            return false;
-    }
-    return true;
+    return generic::MillerRabinTest(number, reliabilityParameter);
 }
 
 bool SoloveyStrassenTest(const BigNumber &number, size_t reliabilityParameter)
 {
     if (number < 4)
         throw std::invalid_argument("Число должно быть больше 3");
-
-    for (size_t i = 0; i < reliabilityParameter; ++i)
-    {
-        auto randBN = Generator(2, number - 2);
-        auto r = PowMod(randBN, (number - 1) / 2, number);
-
-        if (r != 1 && r != number - 1)
-            return false;
-
-        auto jacobiNumber = JacobiNumbers(randBN, number);
-        BigNumber s = (jacobiNumber == -1) ? number - 1 : jacobiNumber;
-
-        if (r != s)
-            return false;
-    }
-    return true;
+    return generic::SoloveyStrassenTest(number, reliabilityParameter);
 }
 
 PrimeFactors Factorize(BigNumber n)
@@ -196,7 +197,7 @@ PrimeFactors Factorize(BigNumber n)
     return factors;
 }
 
-// Корректная реализация теста Люка
+// Тест Люка; n - 1 раскладывается пробным делением
 bool LucasTest(const BigNumber &n, size_t t)
 {
     if (n < 4)
@@ -207,56 +208,13 @@ bool LucasTest(const BigNumber &n, size_t t)
     {
         throw std::invalid_argument("Число должно быть нечетным");
     }
-
-    BigNumber nm1 = n - 1;
-    PrimeFactors factors = Factorize(nm1);
-    bool allConditionsMet = true;
-    for (size_t i = 0; i < t; ++i)
-    {
-        BigNumber a = Generator(2, n - 2);
-
-        if (PowMod(a, nm1, n) != 1)
-            return false;
-
-        for (const auto &[p, exp] : factors)
-        {
-            if (PowMod(a, nm1 / p, n) == 1)
-            {
-                allConditionsMet = false;
-                break;
-            }
-        }
-
-        if (allConditionsMet)
-            return true;
-    }
-    return false;
+    return generic::LucasTest(n, t);
 }
 
 // Генерация случайного простого числа длины bitLength бит
 BigNumber GenerateRandomPrime(size_t bitLength, size_t mrRounds = 25)
 {
-    if (bitLength < 2)
-        throw std::invalid_argument("bitLength must be at least 2");
-
-    // Минимум: 2^(bitLength-1), максимум: 2^bitLength - 1
-    BigNumber min = BigNumber(1) << (bitLength - 1);
-    BigNumber max = (BigNumber(1) << bitLength) - 1;
-
-    while (true)
-    {
-        // 1) Случайное число в диапазоне [min, max]
-        BigNumber candidate = Generator(min, max);
-
-        // 2) Гарантируем, что число нечетное и имеет старший бит = 1
-        candidate |= 1;                               // младший бит = 1 → нечетное
-        candidate |= BigNumber(1) << (bitLength - 1); // старший бит = 1
-
-        // 3) Тест простоты
-        if (MillerRabinTest(candidate, mrRounds))
-            return candidate;
-        // иначе — пробуем заново
-    }
+    return generic::GenerateRandomPrime<BigNumber>(bitLength, mrRounds);
 }
 
 BigNumber GordonsPrimeGenerator()
@@ -274,8 +232,8 @@ BigNumber GordonsPrimeGenerator()
         ++i;
     }
 
-    BigNumber s_pow = PowMod(s, r - 2, r);
-    BigNumber p0 = 2 * s_pow * s - 1;
+    BigNumber s_inv = ModInverse(s, r);
+    BigNumber p0 = 2 * s_inv * s - 1;
 
     BigNumber j = Generator(1, BigNumber(1) << 16);
     BigNumber p;
@@ -288,4 +246,6 @@ BigNumber GordonsPrimeGenerator()
     }
 
     return p;
-}
\ No newline at end of file
+}
+
+#endif // ALGO_HPP
@@ -0,0 +1,289 @@
+#ifndef CANDIDATE_FILE_HPP
+#define CANDIDATE_FILE_HPP
+
+#include "algo.hpp"
+
+#include <boost/endian/conversion.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Бинарный формат файла кандидатов (все поля little-endian):
+//
+//   [заголовок, 32 байта]
+//     magic       char[4]  "BNCF"
+//     version     uint32   версия формата (1)
+//     limbBits    uint32   ширина лимба в битах (64)
+//     flags       uint32   зарезервировано (0)
+//     count       uint64   количество записей
+//     indexOffset uint64   смещение индекса от начала файла
+//   [записи, каждая выровнена на 8 байт]
+//     limbCount   uint32   количество лимбов
+//     recFlags    uint32   бит 0 — отрицательное число
+//     limbs       uint64[limbCount], младший лимб первым
+//   [индекс]
+//     offsets     uint64[count] — смещения записей от начала файла
+//
+// Читатель отображает файл в память и собирает числа прямо из лимбов,
+// без промежуточного десятичного текста.
+namespace candidate_file
+{
+constexpr char MAGIC[4] = {'B', 'N', 'C', 'F'};
+constexpr std::uint32_t VERSION = 1;
+constexpr std::uint32_t LIMB_BITS = 64;
+constexpr std::size_t HEADER_SIZE = 32;
+constexpr std::size_t RECORD_HEADER_SIZE = 8;
+constexpr std::uint32_t NEGATIVE_FLAG = 1;
+
+namespace detail
+{
+template <typename T> void PutLE(std::ostream &out, T value)
+{
+    unsigned char bytes[sizeof(T)];
+    for (std::size_t i = 0; i < sizeof(T); ++i)
+    {
+        bytes[i] = static_cast<unsigned char>(value >> (8 * i));
+    }
+    out.write(reinterpret_cast<const char *>(bytes), sizeof(T));
+}
+
+template <typename T> T GetLE(const unsigned char *bytes)
+{
+    T value = 0;
+    for (std::size_t i = 0; i < sizeof(T); ++i)
+    {
+        value |= static_cast<T>(bytes[i]) << (8 * i);
+    }
+    return value;
+}
+} // namespace detail
+
+/// @brief Последовательная запись чисел в файл кандидатов
+class Writer
+{
+  public:
+    /// @brief Создает (перезаписывает) файл и резервирует место под заголовок
+    /// @param[in] path Путь к файлу
+    /// @throw std::runtime_error если файл не удалось открыть
+    explicit Writer(const std::string &path) : out_(path, std::ios::binary | std::ios::trunc)
+    {
+        if (!out_)
+            throw std::runtime_error("Не удалось открыть файл кандидатов для записи: " + path);
+        const char zeros[HEADER_SIZE] = {};
+        out_.write(zeros, HEADER_SIZE);
+        position_ = HEADER_SIZE;
+    }
+
+    Writer(const Writer &) = delete;
+    Writer &operator=(const Writer &) = delete;
+
+    ~Writer()
+    {
+        if (!closed_)
+        {
+            try
+            {
+                Close();
+            }
+            catch (...)
+            {
+            }
+        }
+    }
+
+    /// @brief Дописывает число в конец файла
+    /// @param[in] value Записываемое число
+    void Append(const BigNumber &value)
+    {
+        if (closed_)
+            throw std::logic_error("Файл кандидатов уже закрыт");
+
+        limbs_.clear();
+        export_bits(value, std::back_inserter(limbs_), LIMB_BITS, false); // знак не экспортируется
+        while (limbs_.size() > 1 && limbs_.back() == 0)
+            limbs_.pop_back();
+
+        offsets_.push_back(position_);
+        detail::PutLE<std::uint32_t>(out_, static_cast<std::uint32_t>(limbs_.size()));
+        detail::PutLE<std::uint32_t>(out_, value < 0 ? NEGATIVE_FLAG : 0);
+        for (std::uint64_t limb : limbs_)
+            detail::PutLE<std::uint64_t>(out_, limb);
+        position_ += RECORD_HEADER_SIZE + limbs_.size() * sizeof(std::uint64_t);
+    }
+
+    /// @brief Записывает индекс и заголовок, закрывает файл
+    /// @throw std::runtime_error при ошибке записи
+    void Close()
+    {
+        if (closed_)
+            return;
+        closed_ = true;
+
+        const std::uint64_t indexOffset = position_;
+        for (std::uint64_t offset : offsets_)
+            detail::PutLE<std::uint64_t>(out_, offset);
+
+        out_.seekp(0);
+        out_.write(MAGIC, sizeof(MAGIC));
+        detail::PutLE<std::uint32_t>(out_, VERSION);
+        detail::PutLE<std::uint32_t>(out_, LIMB_BITS);
+        detail::PutLE<std::uint32_t>(out_, 0);
+        detail::PutLE<std::uint64_t>(out_, offsets_.size());
+        detail::PutLE<std::uint64_t>(out_, indexOffset);
+        out_.close();
+        if (out_.fail())
+            throw std::runtime_error("Ошибка записи файла кандидатов");
+    }
+
+  private:
+    std::ofstream out_;
+    std::uint64_t position_ = 0;
+    std::vector<std::uint64_t> offsets_;
+    std::vector<std::uint64_t> limbs_;
+    bool closed_ = false;
+};
+
+/// @brief Чтение файла кандидатов через отображение в память
+class Reader
+{
+  public:
+    /// @brief Отображает файл в память и проверяет заголовок и индекс
+    /// @param[in] path Путь к файлу
+    /// @throw std::runtime_error если файл поврежден или имеет неизвестный формат
+    /// @throw boost::interprocess::interprocess_exception если файл не существует или не читается
+    explicit Reader(const std::string &path)
+        : mapping_(path.c_str(), boost::interprocess::read_only),
+          region_(mapping_, boost::interprocess::read_only)
+    {
+        data_ = static_cast<const unsigned char *>(region_.get_address());
+        size_ = region_.get_size();
+
+        if (size_ < HEADER_SIZE || std::memcmp(data_, MAGIC, sizeof(MAGIC)) != 0)
+            throw std::runtime_error("Неверная сигнатура файла кандидатов");
+        if (detail::GetLE<std::uint32_t>(data_ + 4) != VERSION)
+            throw std::runtime_error("Неподдерживаемая версия файла кандидатов");
+        if (detail::GetLE<std::uint32_t>(data_ + 8) != LIMB_BITS)
+            throw std::runtime_error("Неподдерживаемая ширина лимба в файле кандидатов");
+
+        count_ = detail::GetLE<std::uint64_t>(data_ + 16);
+        indexOffset_ = detail::GetLE<std::uint64_t>(data_ + 24);
+        if (indexOffset_ < HEADER_SIZE || indexOffset_ > size_ || (size_ - indexOffset_) / sizeof(std::uint64_t) < count_)
+            throw std::runtime_error("Индекс файла кандидатов поврежден");
+    }
+
+    /// @brief Количество чисел в файле
+    std::size_t Size() const
+    {
+        return static_cast<std::size_t>(count_);
+    }
+
+    /// @brief Количество лимбов в записи
+    /// @param[in] index Номер записи
+    std::size_t LimbCount(std::size_t index) const
+    {
+        return detail::GetLE<std::uint32_t>(Record(index));
+    }
+
+    /// @brief Собирает число из записи
+    /// @param[in] index Номер записи
+    /// @return Прочитанное число
+    /// @throw std::out_of_range если номер записи вне диапазона
+    BigNumber operator[](std::size_t index) const
+    {
+        const unsigned char *record = Record(index);
+        const std::size_t limbCount = detail::GetLE<std::uint32_t>(record);
+        const std::uint32_t flags = detail::GetLE<std::uint32_t>(record + 4);
+        const unsigned char *limbs = record + RECORD_HEADER_SIZE;
+
+        BigNumber result;
+        if (boost::endian::order::native == boost::endian::order::little &&
+            reinterpret_cast<std::uintptr_t>(limbs) % alignof(std::uint64_t) == 0)
+        {
+            // Лимбы в файле уже лежат в родном порядке — импортируем их напрямую
+            const std::uint64_t *words = reinterpret_cast<const std::uint64_t *>(limbs);
+            import_bits(result, words, words + limbCount, LIMB_BITS, false);
+        }
+        else
+        {
+            import_bits(result, limbs, limbs + limbCount * sizeof(std::uint64_t), 8, false);
+        }
+        if (flags & NEGATIVE_FLAG)
+            result = -result;
+        return result;
+    }
+
+  private:
+    const unsigned char *Record(std::size_t index) const
+    {
+        if (index >= count_)
+            throw std::out_of_range("Номер записи вне диапазона файла кандидатов");
+        const std::uint64_t offset = detail::GetLE<std::uint64_t>(data_ + indexOffset_ + index * sizeof(std::uint64_t));
+        // Без сложения: offset + RECORD_HEADER_SIZE переполняется для смещений около 2^64
+        if (offset < HEADER_SIZE || offset > indexOffset_ - RECORD_HEADER_SIZE)
+            throw std::runtime_error("Смещение записи вне файла кандидатов");
+        const std::uint64_t limbCount = detail::GetLE<std::uint32_t>(data_ + offset);
+        if ((indexOffset_ - offset - RECORD_HEADER_SIZE) / sizeof(std::uint64_t) < limbCount)
+            throw std::runtime_error("Запись файла кандидатов обрезана");
+        return data_ + offset;
+    }
+
+    boost::interprocess::file_mapping mapping_;
+    boost::interprocess::mapped_region region_;
+    const unsigned char *data_ = nullptr;
+    std::size_t size_ = 0;
+    std::uint64_t count_ = 0;
+    std::uint64_t indexOffset_ = 0;
+};
+
+/// @brief Генерирует случайные простые числа и записывает их в файл кандидатов
+/// @param[in] path Путь к файлу
+/// @param[in] count Количество чисел
+/// @param[in] bitLength Длина каждого числа в битах
+/// @param[in] mrRounds Количество раундов Миллера-Рабина
+inline void WriteRandomPrimes(const std::string &path, std::size_t count, std::size_t bitLength,
+                              std::size_t mrRounds = 25)
+{
+    Writer writer(path);
+    for (std::size_t i = 0; i < count; ++i)
+        writer.Append(GenerateRandomPrime(bitLength, mrRounds));
+    writer.Close();
+}
+
+/// @brief Пакетная проверка всех чисел файла тестом Миллера-Рабина
+/// @param[in] reader Открытый файл кандидатов
+/// @param[in] reliabilityParameter Количество раундов
+/// @return Результат проверки для каждой записи
+inline std::vector<bool> MillerRabinBatch(const Reader &reader, std::size_t reliabilityParameter)
+{
+    std::vector<bool> results(reader.Size());
+    for (std::size_t i = 0; i < reader.Size(); ++i)
+    {
+        const BigNumber candidate = reader[i];
+        if (candidate < 4)
+            results[i] = (candidate == 2 || candidate == 3);
+        else
+            results[i] = MillerRabinTest(candidate, reliabilityParameter);
+    }
+    return results;
+}
+
+/// @brief Пакетное разложение на множители всех чисел файла
+/// @param[in] reader Открытый файл кандидатов
+/// @return Разложение для каждой записи
+inline std::vector<PrimeFactors> FactorizeBatch(const Reader &reader)
+{
+    std::vector<PrimeFactors> results;
+    results.reserve(reader.Size());
+    for (std::size_t i = 0; i < reader.Size(); ++i)
+        results.push_back(Factorize(reader[i]));
+    return results;
+}
+} // namespace candidate_file
+
+#endif // CANDIDATE_FILE_HPP
@@ -0,0 +1,139 @@
+#ifndef FIXED_BASE_HPP
+#define FIXED_BASE_HPP
+
+#include "algo.hpp"
+
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+
+/// @brief Возведение фиксированного основания в степень по фиксированному модулю
+///
+/// Один раз для пары (основание, модуль) строится таблица
+///   T[i][d] = base^(d * 2^(w*i)) mod m,  d = 1..2^w-1,
+/// после чего base^e вычисляется как произведение T[i][e_i] по w-битным
+/// цифрам e_i показателя: около bits/w умножений и ни одного возведения в квадрат.
+/// Таблица занимает ceil(bits/w) * (2^w - 1) вычетов, ширина окна w задает
+/// компромисс между памятью и скоростью.
+class FixedBasePowMod
+{
+  public:
+    /// @brief Строит таблицу предвычислений
+    /// @param[in] base Основание
+    /// @param[in] mod Модуль
+    /// @param[in] maxExponentBits Максимальная длина показателя в битах
+    /// @param[in] windowBits Ширина окна w (1..16)
+    /// @throw std::invalid_argument если модуль не положителен или окно вне диапазона
+    FixedBasePowMod(const BigNumber &base, const BigNumber &mod, size_t maxExponentBits, size_t windowBits = 4)
+        : base_(base), mod_(mod), maxExponentBits_(maxExponentBits), windowBits_(windowBits)
+    {
+        if (mod <= 0)
+            throw std::invalid_argument("Модуль должен быть положительным");
+        if (windowBits < 1 || windowBits > 16)
+            throw std::invalid_argument("Ширина окна должна быть от 1 до 16 бит");
+
+        digitsPerWindow_ = (size_t(1) << windowBits_) - 1;
+        windows_ = (maxExponentBits_ + windowBits_ - 1) / windowBits_;
+        table_.reserve(windows_ * digitsPerWindow_);
+
+        BigNumber g = base % mod_;
+        if (g < 0)
+            g += mod_;
+        for (size_t i = 0; i < windows_; ++i)
+        {
+            // T[i][1] = g, T[i][d] = T[i][d-1] * g, следующее g = g^(2^w) = T[i][2^w-1] * g
+            BigNumber current = g;
+            table_.push_back(current);
+            for (size_t d = 2; d <= digitsPerWindow_; ++d)
+            {
+                current = (current * g) % mod_;
+                table_.push_back(current);
+            }
+            g = (current * g) % mod_;
+        }
+    }
+
+    /// @brief Подбирает наибольшую ширину окна, при которой таблица укладывается в бюджет памяти
+    /// @param[in] maxExponentBits Максимальная длина показателя в битах
+    /// @param[in] modBits Длина модуля в битах
+    /// @param[in] maxTableBytes Допустимый объем таблицы в байтах
+    /// @return Ширина окна (не меньше 1)
+    static size_t WindowForBudget(size_t maxExponentBits, size_t modBits, size_t maxTableBytes)
+    {
+        const size_t entryBytes = (modBits + 7) / 8;
+        size_t best = 1;
+        for (size_t w = 1; w <= 16; ++w)
+        {
+            const size_t entries = ((maxExponentBits + w - 1) / w) * ((size_t(1) << w) - 1);
+            if (entries * entryBytes > maxTableBytes)
+                break;
+            best = w;
+        }
+        return best;
+    }
+
+    /// @brief Вычисляет base^exponent mod m
+    /// @param[in] exponent Неотрицательный показатель
+    /// @return Результат возведения в степень
+    /// @throw std::invalid_argument если показатель отрицателен
+    BigNumber operator()(const BigNumber &exponent) const
+    {
+        if (exponent < 0)
+            throw std::invalid_argument("Показатель должен быть неотрицательным");
+        if (BitLength(exponent) > maxExponentBits_)
+            return PowMod(base_, exponent, mod_); // показатель не покрыт таблицей
+
+        std::vector<std::uint64_t> words;
+        export_bits(exponent, std::back_inserter(words), 64, false);
+
+        BigNumber result = 1 % mod_;
+        for (size_t i = 0; i < windows_; ++i)
+        {
+            const size_t digit = Digit(words, i * windowBits_);
+            if (digit != 0)
+                result = (result * table_[i * digitsPerWindow_ + digit - 1]) % mod_;
+        }
+        return result;
+    }
+
+    /// @brief Количество вычетов в таблице
+    size_t TableEntries() const
+    {
+        return table_.size();
+    }
+
+    /// @brief Ширина окна
+    size_t WindowBits() const
+    {
+        return windowBits_;
+    }
+
+  private:
+    static size_t BitLength(const BigNumber &value)
+    {
+        return value == 0 ? 0 : static_cast<size_t>(msb(value)) + 1;
+    }
+
+    size_t Digit(const std::vector<std::uint64_t> &words, size_t bit) const
+    {
+        const size_t word = bit / 64;
+        const size_t shift = bit % 64;
+        if (word >= words.size())
+            return 0;
+        std::uint64_t value = words[word] >> shift;
+        if (shift + windowBits_ > 64 && word + 1 < words.size())
+            value |= words[word + 1] << (64 - shift);
+        return static_cast<size_t>(value & digitsPerWindow_);
+    }
+
+    BigNumber base_;
+    BigNumber mod_;
+    size_t maxExponentBits_;
+    size_t windowBits_;
+    size_t digitsPerWindow_ = 0;
+    size_t windows_ = 0;
+    std::vector<BigNumber> table_; ///< T[i][d] хранится по индексу i * (2^w - 1) + d - 1
+};
+
+#endif // FIXED_BASE_HPP
@@ -1,4 +1,8 @@
 #include "algo.hpp"
+#include "candidate_file.hpp"
+#include "fixed_base.hpp"
+#include "multi_exp.hpp"
+#include "rsa.hpp"
 #include <cassert>
 #include <chrono>
 #include <iostream>
@@ -164,6 +168,211 @@ void GordonTest()
     std::cout << "Miller-Rabin Test result: " << MillerRabinTest(result, 25) << "\n";
 }
 
+void CandidateFileTest()
+{
+    const std::string path = "candidates.bncf";
+    size_t count, bitLength;
+    std::cout << "Candidates count: ";
+    std::cin >> count;
+    std::cout << "Bit length: ";
+    std::cin >> bitLength;
+
+    auto start = std::chrono::high_resolution_clock::now();
+    candidate_file::WriteRandomPrimes(path, count, bitLength);
+    auto end = std::chrono::high_resolution_clock::now();
+    std::cout << "Write time: " << std::chrono::duration<double>(end - start).count() << "s\n";
+
+    start = std::chrono::high_resolution_clock::now();
+    candidate_file::Reader reader(path);
+    auto results = candidate_file::MillerRabinBatch(reader, 25);
+    end = std::chrono::high_resolution_clock::now();
+
+    size_t primes = 0;
+    for (bool isPrime : results)
+        primes += isPrime;
+    std::cout << "Primes in file: " << primes << " / " << reader.Size() << "\n";
+    std::cout << "Read + check time: " << std::chrono::duration<double>(end - start).count() << "s\n";
+
+    // Поврежденный индекс: смещение записи около 2^64 должно отвергаться, а не читаться
+    const std::string corruptedPath = "corrupted.bncf";
+    {
+        std::ofstream out(corruptedPath, std::ios::binary | std::ios::trunc);
+        out.write(candidate_file::MAGIC, sizeof(candidate_file::MAGIC));
+        candidate_file::detail::PutLE<std::uint32_t>(out, candidate_file::VERSION);
+        candidate_file::detail::PutLE<std::uint32_t>(out, candidate_file::LIMB_BITS);
+        candidate_file::detail::PutLE<std::uint32_t>(out, 0);
+        candidate_file::detail::PutLE<std::uint64_t>(out, 1);  // count
+        candidate_file::detail::PutLE<std::uint64_t>(out, 40); // indexOffset
+        candidate_file::detail::PutLE<std::uint64_t>(out, 0);  // пустая запись
+        candidate_file::detail::PutLE<std::uint64_t>(out, 0xFFFFFFFFFFFFFFFCULL);
+    }
+    bool rejected = false;
+    try
+    {
+        candidate_file::Reader corrupted(corruptedPath);
+        corrupted[0];
+    }
+    catch (const std::runtime_error &)
+    {
+        rejected = true;
+    }
+    std::cout << "Corrupted index rejected: " << rejected << "\n";
+}
+
+void FixedBaseTest()
+{
+    size_t exponents;
+    std::cout << "Exponents count: ";
+    std::cin >> exponents;
+
+    BigNumber p = GordonsPrimeGenerator();
+    BigNumber g = Generator(2, p - 2);
+    size_t bits = static_cast<size_t>(msb(p)) + 1;
+
+    auto start = std::chrono::high_resolution_clock::now();
+    FixedBasePowMod fixedBase(g, p, bits, FixedBasePowMod::WindowForBudget(bits, bits, 1 << 20));
+    auto end = std::chrono::high_resolution_clock::now();
+    std::cout << "Window: " << fixedBase.WindowBits() << ", table entries: " << fixedBase.TableEntries() << "\n";
+    std::cout << "Precomputation time: " << std::chrono::duration<double>(end - start).count() << "s\n";
+
+    std::vector<BigNumber> exps;
+    for (size_t i = 0; i < exponents; ++i)
+        exps.push_back(Generator(1, p - 1));
+
+    start = std::chrono::high_resolution_clock::now();
+    std::vector<BigNumber> fixedResults;
+    for (const auto &e : exps)
+        fixedResults.push_back(fixedBase(e));
+    end = std::chrono::high_resolution_clock::now();
+    std::cout << "FixedBasePowMod time: " << std::chrono::duration<double>(end - start).count() << "s\n";
+
+    start = std::chrono::high_resolution_clock::now();
+    bool equal = true;
+    for (size_t i = 0; i < exps.size(); ++i)
+        equal = equal && (PowMod(g, exps[i], p) == fixedResults[i]);
+    end = std::chrono::high_resolution_clock::now();
+    std::cout << "PowMod time: " << std::chrono::duration<double>(end - start).count() << "s\n";
+    std::cout << "Results equal: " << equal << "\n";
+}
+
+void MultiExpTest()
+{
+    size_t terms;
+    std::cout << "Batch terms count: ";
+    std::cin >> terms;
+
+    BigNumber p = GordonsPrimeGenerator();
+    BigNumber g = Generator(2, p - 2);
+    BigNumber h = Generator(2, p - 2);
+    BigNumber a = Generator(1, p - 1);
+    BigNumber b = Generator(1, p - 1);
+
+    // Два слагаемых (окна Штрауса) против двух отдельных возведений в степень
+    auto start = std::chrono::high_resolution_clock::now();
+    BigNumber multi = MultiPowMod({{g, a}, {h, b}}, p);
+    auto end = std::chrono::high_resolution_clock::now();
+    std::cout << "MultiPowMod(g^a * h^b) time: " << std::chrono::duration<double>(end - start).count() << "s\n";
+
+    start = std::chrono::high_resolution_clock::now();
+    BigNumber separate = PowMod(g, a, p) * PowMod(h, b, p) % p;
+    end = std::chrono::high_resolution_clock::now();
+    std::cout << "PowMod * PowMod time: " << std::chrono::duration<double>(end - start).count() << "s\n";
+    std::cout << "Results equal: " << (multi == separate) << "\n";
+
+    // Пакет из не менее чем 32 слагаемых идет через корзины Пиппенджера
+    terms = std::max<size_t>(terms, multi_exp_detail::PIPPENGER_THRESHOLD);
+    PowTerms batch;
+    for (size_t i = 0; i < terms; ++i)
+        batch.emplace_back(Generator(2, p - 2), Generator(0, p - 1));
+
+    start = std::chrono::high_resolution_clock::now();
+    multi = MultiPowMod(batch, p);
+    end = std::chrono::high_resolution_clock::now();
+    std::cout << "MultiPowMod batch (" << terms << " terms) time: "
+              << std::chrono::duration<double>(end - start).count() << "s\n";
+
+    start = std::chrono::high_resolution_clock::now();
+    separate = 1;
+    for (const auto &[base, exp] : batch)
+        separate = separate * PowMod(base, exp, p) % p;
+    end = std::chrono::high_resolution_clock::now();
+    std::cout << "PowMod product time: " << std::chrono::duration<double>(end - start).count() << "s\n";
+    std::cout << "Results equal: " << (multi == separate) << "\n";
+}
+
+void BatchInverseTest()
+{
+    size_t count;
+    std::cout << "Values count: ";
+    std::cin >> count;
+
+    BigNumber p = GordonsPrimeGenerator();
+    std::vector<BigNumber> values;
+    for (size_t i = 0; i < count; ++i)
+        values.push_back(Generator(1, p - 1));
+
+    auto start = std::chrono::high_resolution_clock::now();
+    auto inverses = BatchModInverse(values, p);
+    auto end = std::chrono::high_resolution_clock::now();
+    std::cout << "BatchModInverse time: " << std::chrono::duration<double>(end - start).count() << "s\n";
+
+    start = std::chrono::high_resolution_clock::now();
+    std::vector<BigNumber> single;
+    for (const auto &value : values)
+        single.push_back(ModInverse(value, p));
+    end = std::chrono::high_resolution_clock::now();
+    std::cout << "ModInverse time: " << std::chrono::duration<double>(end - start).count() << "s\n";
+
+    bool equal = true;
+    for (size_t i = 0; i < values.size(); ++i)
+        equal = equal && single[i] == inverses[i] && values[i] * inverses[i] % p == 1;
+    std::cout << "Results equal: " << equal << "\n";
+
+    // Необратимый элемент (кратный модулю) делает необратимым все произведение
+    values.push_back(p);
+    bool thrown = false;
+    try
+    {
+        BatchModInverse(values, p);
+    }
+    catch (const std::invalid_argument &)
+    {
+        thrown = true;
+    }
+    std::cout << "Non-invertible element rejected: " << thrown << "\n";
+}
+
+void RsaTest()
+{
+    size_t bits, messages;
+    std::cout << "RSA modulus bits: ";
+    std::cin >> bits;
+    std::cout << "Messages count: ";
+    std::cin >> messages;
+
+    auto start = std::chrono::high_resolution_clock::now();
+    RsaKey key = GenerateRsaKey(bits);
+    auto end = std::chrono::high_resolution_clock::now();
+    std::cout << "Key generation time: " << std::chrono::duration<double>(end - start).count() << "s\n";
+
+    std::vector<BigNumber> ciphertexts;
+    for (size_t i = 0; i < messages; ++i)
+        ciphertexts.push_back(RsaPublic(key, Generator(0, key.n - 1)));
+
+    start = std::chrono::high_resolution_clock::now();
+    auto plain = RsaPrivateOperation(key).Batch(ciphertexts);
+    end = std::chrono::high_resolution_clock::now();
+    std::cout << "CRT batch time: " << std::chrono::duration<double>(end - start).count() << "s\n";
+
+    start = std::chrono::high_resolution_clock::now();
+    bool equal = true;
+    for (size_t i = 0; i < ciphertexts.size(); ++i)
+        equal = equal && (PowMod(ciphertexts[i], key.d, key.n) == plain[i]);
+    end = std::chrono::high_resolution_clock::now();
+    std::cout << "PowMod(c, d, n) time: " << std::chrono::duration<double>(end - start).count() << "s\n";
+    std::cout << "Results equal: " << equal << "\n";
+}
+
 int main()
 {
     srand(static_cast<unsigned int>(time(NULL)));
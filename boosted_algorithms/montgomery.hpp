@@ -0,0 +1,138 @@
+#ifndef MONTGOMERY_HPP
+#define MONTGOMERY_HPP
+
+#include "algo.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+
+/// @brief Контекст арифметики Монтгомери для нечетного модуля n
+///
+/// R = 2^k, где k — длина n, округленная вверх до 64 бит. Редукция
+/// REDC(t) = (t + ((t mod R) * n') mod R * n) / R использует только умножения,
+/// маски и сдвиги вместо деления на n. Контекст не изменяется после
+/// построения, поэтому его можно разделять между потоками.
+class MontgomeryContext
+{
+  public:
+    /// @brief Строит контекст для модуля
+    /// @param[in] mod Нечетный модуль больше 1
+    /// @throw std::invalid_argument если модуль четный или не больше 1
+    explicit MontgomeryContext(const BigNumber &mod) : mod_(mod)
+    {
+        if (mod <= 1 || mod % 2 == 0)
+            throw std::invalid_argument("Модуль Монтгомери должен быть нечетным и больше 1");
+
+        rBits_ = (static_cast<unsigned>(msb(mod)) / 64 + 1) * 64;
+        rMask_ = (BigNumber(1) << rBits_) - 1;
+
+        // Итерация Ньютона x = x * (2 - n * x) удваивает число верных младших бит n^(-1)
+        BigNumber inverse = 1;
+        for (unsigned bits = 1; bits < rBits_; bits *= 2)
+            inverse = (inverse * (2 - mod_ * inverse)) & rMask_;
+        nPrime_ = (rMask_ + 1 - inverse) & rMask_;
+
+        rSquared_ = (BigNumber(1) << (2 * rBits_)) % mod_;
+        one_ = (BigNumber(1) << rBits_) % mod_;
+    }
+
+    /// @brief Модуль контекста
+    const BigNumber &Modulus() const
+    {
+        return mod_;
+    }
+
+    /// @brief Переводит число в форму Монтгомери: a * R mod n
+    BigNumber ToMontgomery(const BigNumber &a) const
+    {
+        BigNumber reduced = a % mod_;
+        if (reduced < 0)
+            reduced += mod_;
+        return Reduce(reduced * rSquared_);
+    }
+
+    /// @brief Возвращает число из формы Монтгомери: a * R^(-1) mod n
+    BigNumber FromMontgomery(const BigNumber &a) const
+    {
+        return Reduce(a);
+    }
+
+    /// @brief Произведение в форме Монтгомери: a * b * R^(-1) mod n
+    BigNumber Multiply(const BigNumber &a, const BigNumber &b) const
+    {
+        return Reduce(a * b);
+    }
+
+    /// @brief Модульное возведение в степень скользящим окном в форме Монтгомери
+    /// @param[in] base Основание (в обычной форме)
+    /// @param[in] exp Неотрицательный показатель
+    /// @return base^exp mod n (в обычной форме)
+    BigNumber PowMod(const BigNumber &base, const BigNumber &exp) const
+    {
+        if (exp < 0)
+            throw std::invalid_argument("Показатель должен быть неотрицательным");
+        if (exp == 0)
+            return 1;
+
+        const unsigned bits = static_cast<unsigned>(msb(exp)) + 1;
+        const unsigned w = bits > 768 ? 6 : (bits > 240 ? 5 : (bits > 80 ? 4 : (bits > 24 ? 3 : 1)));
+
+        // Нечетные степени base^1, base^3, ..., base^(2^w - 1)
+        std::vector<BigNumber> odd(size_t(1) << (w - 1));
+        odd[0] = ToMontgomery(base);
+        const BigNumber square = Multiply(odd[0], odd[0]);
+        for (size_t i = 1; i < odd.size(); ++i)
+            odd[i] = Multiply(odd[i - 1], square);
+
+        std::vector<std::uint64_t> words;
+        export_bits(exp, std::back_inserter(words), 64, false);
+        auto bit = [&words](unsigned i) { return (words[i / 64] >> (i % 64)) & 1; };
+
+        BigNumber result = one_;
+        int i = static_cast<int>(bits) - 1;
+        while (i >= 0)
+        {
+            if (!bit(i))
+            {
+                result = Multiply(result, result);
+                --i;
+                continue;
+            }
+            // Окно [i, j] максимальной длины w, заканчивающееся единичным битом
+            int j = std::max(i - static_cast<int>(w) + 1, 0);
+            while (!bit(j))
+                ++j;
+            unsigned value = 0;
+            for (int k = i; k >= j; --k)
+            {
+                result = Multiply(result, result);
+                value = (value << 1) | static_cast<unsigned>(bit(k));
+            }
+            result = Multiply(result, odd[value >> 1]);
+            i = j - 1;
+        }
+        return FromMontgomery(result);
+    }
+
+  private:
+    BigNumber Reduce(const BigNumber &t) const
+    {
+        BigNumber m = ((t & rMask_) * nPrime_) & rMask_;
+        BigNumber u = (t + m * mod_) >> rBits_;
+        if (u >= mod_)
+            u -= mod_;
+        return u;
+    }
+
+    BigNumber mod_;
+    BigNumber nPrime_;   ///< -n^(-1) mod R
+    BigNumber rMask_;    ///< R - 1
+    BigNumber rSquared_; ///< R^2 mod n
+    BigNumber one_;      ///< R mod n — единица в форме Монтгомери
+    unsigned rBits_ = 0;
+};
+
+#endif // MONTGOMERY_HPP
@@ -0,0 +1,184 @@
+#ifndef MULTI_EXP_HPP
+#define MULTI_EXP_HPP
+
+#include "algo.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+using PowTerms = std::vector<std::pair<BigNumber, BigNumber>>; ///< Пары (основание, показатель)
+
+namespace multi_exp_detail
+{
+// Число слагаемых, начиная с которого корзины Пиппенджера выгоднее таблиц Штрауса
+constexpr size_t PIPPENGER_THRESHOLD = 32;
+
+struct Exponent
+{
+    std::vector<std::uint64_t> words; ///< Показатель по 64 бита, младшее слово первым
+
+    size_t Digit(size_t bit, size_t width) const
+    {
+        const size_t word = bit / 64;
+        const size_t shift = bit % 64;
+        if (word >= words.size())
+            return 0;
+        std::uint64_t value = words[word] >> shift;
+        if (shift + width > 64 && word + 1 < words.size())
+            value |= words[word + 1] << (64 - shift);
+        return static_cast<size_t>(value & ((std::uint64_t(1) << width) - 1));
+    }
+};
+
+// Подготовка: приведение оснований по модулю и разбор показателей на слова
+inline size_t Prepare(const PowTerms &terms, const BigNumber &mod, std::vector<BigNumber> &bases,
+                      std::vector<Exponent> &exponents)
+{
+    size_t maxBits = 0;
+    bases.reserve(terms.size());
+    exponents.resize(terms.size());
+    for (size_t j = 0; j < terms.size(); ++j)
+    {
+        const auto &[base, exp] = terms[j];
+        if (exp < 0)
+            throw std::invalid_argument("Показатель должен быть неотрицательным");
+        BigNumber b = base % mod;
+        if (b < 0)
+            b += mod;
+        bases.push_back(b);
+        if (exp != 0)
+        {
+            export_bits(exp, std::back_inserter(exponents[j].words), 64, false);
+            maxBits = std::max(maxBits, static_cast<size_t>(msb(exp)) + 1);
+        }
+    }
+    return maxBits;
+}
+
+// Возводит result в степень 2^count, пропуская квадраты единицы
+inline void SquareTimes(BigNumber &result, size_t count, bool isOne, const BigNumber &mod)
+{
+    if (isOne)
+        return;
+    for (size_t k = 0; k < count; ++k)
+        result = (result * result) % mod;
+}
+
+inline void MultiplyInto(BigNumber &result, const BigNumber &factor, bool &isOne, const BigNumber &mod)
+{
+    result = isOne ? factor : (result * factor) % mod;
+    isOne = false;
+}
+
+// Штраус: для каждого основания таблица b^d, d < 2^w, общие квадраты для всех слагаемых
+inline BigNumber Straus(const std::vector<BigNumber> &bases, const std::vector<Exponent> &exponents, size_t maxBits,
+                        const BigNumber &mod)
+{
+    const size_t w = maxBits > 512 ? 5 : (maxBits > 128 ? 4 : (maxBits > 24 ? 3 : 1));
+    const size_t digits = size_t(1) << w;
+
+    std::vector<std::vector<BigNumber>> tables(bases.size());
+    for (size_t j = 0; j < bases.size(); ++j)
+    {
+        tables[j].resize(digits);
+        tables[j][1] = bases[j];
+        for (size_t d = 2; d < digits; ++d)
+            tables[j][d] = (tables[j][d - 1] * bases[j]) % mod;
+    }
+
+    BigNumber result = 1;
+    bool isOne = true;
+    const size_t windows = (maxBits + w - 1) / w;
+    for (size_t i = windows; i-- > 0;)
+    {
+        SquareTimes(result, w, isOne, mod);
+        for (size_t j = 0; j < bases.size(); ++j)
+        {
+            const size_t d = exponents[j].Digit(i * w, w);
+            if (d != 0)
+                MultiplyInto(result, tables[j][d], isOne, mod);
+        }
+    }
+    return result;
+}
+
+// Пиппенджер: основания раскладываются по корзинам цифр окна, затем
+// произведение B[d]^d по всем d собирается бегущими произведениями
+inline BigNumber Pippenger(const std::vector<BigNumber> &bases, const std::vector<Exponent> &exponents,
+                           size_t maxBits, const BigNumber &mod)
+{
+    size_t c = 1;
+    while ((size_t(1) << (c + 2)) <= bases.size() && c < 16)
+        ++c;
+    const size_t buckets = (size_t(1) << c) - 1;
+
+    std::vector<BigNumber> bucket(buckets);
+    std::vector<bool> used(buckets);
+
+    BigNumber result = 1;
+    bool isOne = true;
+    const size_t windows = (maxBits + c - 1) / c;
+    for (size_t i = windows; i-- > 0;)
+    {
+        SquareTimes(result, c, isOne, mod);
+
+        std::fill(used.begin(), used.end(), false);
+        for (size_t j = 0; j < bases.size(); ++j)
+        {
+            const size_t d = exponents[j].Digit(i * c, c);
+            if (d == 0)
+                continue;
+            if (used[d - 1])
+                bucket[d - 1] = (bucket[d - 1] * bases[j]) % mod;
+            else
+                bucket[d - 1] = bases[j];
+            used[d - 1] = true;
+        }
+
+        // running = B[top] * ... * B[d], windowSum = running_top * ... * running_1 = prod B[d]^d
+        BigNumber running, windowSum;
+        bool runningIsOne = true, windowIsOne = true;
+        for (size_t d = buckets; d >= 1; --d)
+        {
+            if (used[d - 1])
+                MultiplyInto(running, bucket[d - 1], runningIsOne, mod);
+            if (!runningIsOne)
+                MultiplyInto(windowSum, running, windowIsOne, mod);
+        }
+        if (!windowIsOne)
+            MultiplyInto(result, windowSum, isOne, mod);
+    }
+    return result;
+}
+} // namespace multi_exp_detail
+
+/// @brief Одновременное возведение в степень: prod(b_j^e_j) mod m
+///
+/// Возведения в квадрат общие для всех слагаемых. Для малого числа слагаемых
+/// используются чередующиеся окна Штрауса, для большого — корзины Пиппенджера.
+/// @param[in] terms Пары (основание, неотрицательный показатель)
+/// @param[in] mod Положительный модуль
+/// @return Произведение степеней по модулю
+/// @throw std::invalid_argument если модуль не положителен или показатель отрицателен
+inline BigNumber MultiPowMod(const PowTerms &terms, const BigNumber &mod)
+{
+    if (mod <= 0)
+        throw std::invalid_argument("Модуль должен быть положительным");
+
+    std::vector<BigNumber> bases;
+    std::vector<multi_exp_detail::Exponent> exponents;
+    const size_t maxBits = multi_exp_detail::Prepare(terms, mod, bases, exponents);
+    if (maxBits == 0)
+        return 1 % mod;
+
+    BigNumber result = terms.size() < multi_exp_detail::PIPPENGER_THRESHOLD
+                           ? multi_exp_detail::Straus(bases, exponents, maxBits, mod)
+                           : multi_exp_detail::Pippenger(bases, exponents, maxBits, mod);
+    return result % mod;
+}
+
+#endif // MULTI_EXP_HPP
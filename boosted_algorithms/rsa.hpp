@@ -0,0 +1,165 @@
+#ifndef RSA_HPP
+#define RSA_HPP
+
+#include "algo.hpp"
+#include "montgomery.hpp"
+
+#include <algorithm>
+#include <future>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+/// @brief Ключ RSA с параметрами китайской теоремы об остатках
+struct RsaKey
+{
+    BigNumber n;    ///< Модуль n = p * q
+    BigNumber e;    ///< Открытая экспонента
+    BigNumber d;    ///< Закрытая экспонента, e * d = 1 mod lcm(p - 1, q - 1)
+    BigNumber p;    ///< Первый простой множитель (p > q)
+    BigNumber q;    ///< Второй простой множитель
+    BigNumber dP;   ///< d mod (p - 1)
+    BigNumber dQ;   ///< d mod (q - 1)
+    BigNumber qInv; ///< q^(-1) mod p
+};
+
+namespace rsa_detail
+{
+// Простое длины bits с двумя старшими единичными битами (чтобы p * q имело ровно 2 * bits бит)
+// и с gcd(p - 1, e) = 1
+inline BigNumber GenerateRsaPrime(size_t bits, const BigNumber &e, size_t mrRounds)
+{
+    const BigNumber topBits = BigNumber(3) << (bits - 2);
+    const BigNumber min = BigNumber(1) << (bits - 1);
+    const BigNumber max = (BigNumber(1) << bits) - 1;
+    while (true)
+    {
+        BigNumber candidate = Generator(min, max) | topBits | 1;
+        if (gcd(candidate - 1, e) != 1)
+            continue;
+        if (MillerRabinTest(candidate, mrRounds))
+            return candidate;
+    }
+}
+} // namespace rsa_detail
+
+/// @brief Генерирует ключ RSA; p и q ищутся одновременно в двух потоках
+/// @param[in] modulusBits Длина модуля n в битах (четная, не меньше 64)
+/// @param[in] e Открытая экспонента (нечетная, больше 1)
+/// @param[in] mrRounds Количество раундов Миллера-Рабина для p и q
+/// @return Ключ со всеми параметрами CRT
+/// @throw std::invalid_argument при неверных параметрах
+inline RsaKey GenerateRsaKey(size_t modulusBits, const BigNumber &e = 65537, size_t mrRounds = 25)
+{
+    if (modulusBits < 64 || modulusBits % 2 != 0)
+        throw std::invalid_argument("Длина модуля RSA должна быть четной и не меньше 64 бит");
+    if (e < 3 || e % 2 == 0)
+        throw std::invalid_argument("Открытая экспонента должна быть нечетной и больше 1");
+
+    const size_t halfBits = modulusBits / 2;
+    // p и q должны различаться хотя бы в старших битах, иначе n раскладывается методом Ферма
+    const BigNumber minDistance = BigNumber(1) << (halfBits > 100 ? halfBits - 100 : halfBits / 2);
+
+    RsaKey key;
+    key.e = e;
+    while (true)
+    {
+        auto pFuture = std::async(std::launch::async, rsa_detail::GenerateRsaPrime, halfBits, e, mrRounds);
+        BigNumber q = rsa_detail::GenerateRsaPrime(halfBits, e, mrRounds);
+        BigNumber p = pFuture.get();
+        if (p < q)
+            std::swap(p, q);
+        if (p - q > minDistance)
+        {
+            key.p = p;
+            key.q = q;
+            break;
+        }
+    }
+
+    const BigNumber pm1 = key.p - 1;
+    const BigNumber qm1 = key.q - 1;
+    const BigNumber lambda = pm1 / gcd(pm1, qm1) * qm1;
+
+    key.n = key.p * key.q;
+    key.d = ModInverse(e, lambda);
+    key.dP = key.d % pm1;
+    key.dQ = key.d % qm1;
+    key.qInv = ModInverse(key.q, key.p);
+    return key;
+}
+
+/// @brief Открытая операция RSA: m^e mod n (шифрование, проверка подписи)
+inline BigNumber RsaPublic(const RsaKey &key, const BigNumber &message)
+{
+    return MontgomeryContext(key.n).PowMod(message, key.e);
+}
+
+/// @brief Закрытая операция RSA через CRT (расшифрование, подпись)
+///
+/// Вместо c^d mod n выполняются два возведения в степень половинной длины
+/// по модулям p и q в форме Монтгомери и сборка по формуле Гарнера.
+/// Контексты Монтгомери строятся один раз; объект можно разделять между потоками.
+class RsaPrivateOperation
+{
+  public:
+    explicit RsaPrivateOperation(const RsaKey &key) : key_(key), pContext_(key.p), qContext_(key.q)
+    {
+    }
+
+    /// @brief Вычисляет c^d mod n
+    /// @param[in] c Шифртекст или сообщение для подписи, 0 <= c < n
+    BigNumber operator()(const BigNumber &c) const
+    {
+        const BigNumber m1 = pContext_.PowMod(c, key_.dP);
+        const BigNumber m2 = qContext_.PowMod(c, key_.dQ);
+        BigNumber h = (key_.qInv * (m1 - m2)) % key_.p;
+        if (h < 0)
+            h += key_.p;
+        return m2 + h * key_.q;
+    }
+
+    /// @brief Пакетная обработка: сообщения делятся между всеми ядрами
+    /// @param[in] inputs Шифртексты или сообщения для подписи
+    /// @param[in] threads Количество потоков (0 — по числу ядер)
+    /// @return Результаты в том же порядке
+    std::vector<BigNumber> Batch(const std::vector<BigNumber> &inputs, size_t threads = 0) const
+    {
+        std::vector<BigNumber> results(inputs.size());
+        if (threads == 0)
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        threads = std::min(threads, inputs.size());
+        if (threads <= 1)
+        {
+            for (size_t i = 0; i < inputs.size(); ++i)
+                results[i] = (*this)(inputs[i]);
+            return results;
+        }
+
+        std::vector<std::future<void>> workers;
+        workers.reserve(threads);
+        for (size_t t = 0; t < threads; ++t)
+        {
+            workers.push_back(std::async(std::launch::async, [this, &inputs, &results, t, threads]() {
+                for (size_t i = t; i < inputs.size(); i += threads)
+                    results[i] = (*this)(inputs[i]);
+            }));
+        }
+        for (auto &worker : workers)
+            worker.get();
+        return results;
+    }
+
+  private:
+    RsaKey key_;
+    MontgomeryContext pContext_;
+    MontgomeryContext qContext_;
+};
+
+/// @brief Закрытая операция RSA через CRT для одного сообщения
+inline BigNumber RsaPrivate(const RsaKey &key, const BigNumber &c)
+{
+    return RsaPrivateOperation(key)(c);
+}
+
+#endif // RSA_HPP
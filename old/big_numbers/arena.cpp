@@ -0,0 +1,213 @@
+#include "arena.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+
+namespace big_number
+{
+namespace
+{
+thread_local Arena *currentArena = nullptr; ///< Установленная ArenaScope арена
+thread_local Arena *threadArena = nullptr;  ///< Арена потока, пока она существует
+
+// Номер списка: наименьшее i, при котором 2^i >= bytes и 2^i >= ALIGNMENT
+int SizeClass(std::size_t bytes)
+{
+    int sizeClass = 0;
+    while ((std::size_t(1) << sizeClass) < std::max(bytes, Arena::ALIGNMENT))
+        ++sizeClass;
+    return sizeClass;
+}
+} // namespace
+
+Arena::~Arena()
+{
+    // Буферы, освобождаемые после уничтожения арены потока (другими thread_local объектами), идут в кучу
+    if (threadArena == this)
+        threadArena = nullptr;
+    if (currentArena == this)
+        currentArena = nullptr;
+    for (const Block &block : blocks_)
+        ::operator delete(block.data);
+}
+
+void *Arena::Allocate(std::size_t bytes)
+{
+    const int sizeClass = SizeClass(bytes);
+    ++stats_.allocations;
+    if (void *pointer = free_[sizeClass])
+    {
+        free_[sizeClass] = *static_cast<void **>(pointer);
+        ++stats_.reused;
+        return pointer;
+    }
+
+    bytes = std::size_t(1) << sizeClass;
+    if (blocks_.empty() || offset_ + bytes > blocks_[current_].size)
+        NextBlock(bytes);
+
+    void *pointer = blocks_[current_].data + offset_;
+    offset_ += bytes;
+    stats_.bytesAllocated += bytes;
+    stats_.peakBytes = std::max(stats_.peakBytes, before_ + offset_);
+    return pointer;
+}
+
+void Arena::Deallocate(void *pointer, std::size_t bytes)
+{
+    assert(scopes_ > 0 && IsLive(pointer) && "An arena buffer outlived its ArenaScope");
+    // Последний выданный буфер возвращается сдвигом позиции, остальные — в список своего размера
+    const int sizeClass = SizeClass(bytes);
+    bytes = std::size_t(1) << sizeClass;
+    if (offset_ >= bytes && static_cast<char *>(pointer) == blocks_[current_].data + offset_ - bytes)
+    {
+        offset_ -= bytes;
+        return;
+    }
+    *static_cast<void **>(pointer) = free_[sizeClass];
+    free_[sizeClass] = pointer;
+}
+
+bool Arena::Owns(const void *pointer) const
+{
+    const char *p = static_cast<const char *>(pointer);
+    for (const Block &block : blocks_)
+    {
+        if (p >= block.data && p < block.data + block.size)
+            return true;
+    }
+    return false;
+}
+
+bool Arena::IsLive(const void *pointer) const
+{
+    const char *p = static_cast<const char *>(pointer);
+    for (std::size_t i = 0; i <= current_ && i < blocks_.size(); ++i)
+    {
+        const std::size_t used = i == current_ ? offset_ : blocks_[i].size;
+        if (p >= blocks_[i].data && p < blocks_[i].data + used)
+            return true;
+    }
+    return false;
+}
+
+Arena::Mark Arena::GetMark() const
+{
+    return {current_, offset_};
+}
+
+void Arena::Rewind(Mark mark)
+{
+    for (std::size_t i = mark.block; i < current_; ++i)
+        before_ -= blocks_[i].size;
+    current_ = mark.block;
+    offset_ = mark.offset;
+    // Списки могут ссылаться на память за отметкой; буферы до нее вернет внешний откат
+    std::fill(std::begin(free_), std::end(free_), nullptr);
+    ++stats_.rewinds;
+}
+
+ArenaStats Arena::Stats() const
+{
+    return stats_;
+}
+
+void Arena::ResetStats()
+{
+    const std::size_t reserved = stats_.bytesReserved;
+    stats_ = ArenaStats();
+    stats_.bytesReserved = reserved;
+}
+
+void Arena::NextBlock(std::size_t bytes)
+{
+    // Блоки после текущего остались от прошлых проходов и переиспользуются
+    if (!blocks_.empty())
+    {
+        if (current_ + 1 < blocks_.size() && blocks_[current_ + 1].size >= bytes)
+        {
+            before_ += blocks_[current_].size;
+            ++current_;
+            offset_ = 0;
+            return;
+        }
+    }
+
+    // Новый блок вдвое больше последнего; он вставляется сразу за текущим,
+    // на блоки дальше текущего отметки не ссылаются
+    const std::size_t size = std::max({MIN_BLOCK_SIZE, bytes, blocks_.empty() ? 0 : 2 * blocks_.back().size});
+    const Block block{static_cast<char *>(::operator new(size)), size};
+    ++stats_.heapBlocks;
+    stats_.bytesReserved += size;
+    if (blocks_.empty())
+    {
+        blocks_.push_back(block);
+        current_ = 0;
+    }
+    else
+    {
+        before_ += blocks_[current_].size;
+        blocks_.insert(blocks_.begin() + static_cast<std::ptrdiff_t>(current_) + 1, block);
+        ++current_;
+    }
+    offset_ = 0;
+}
+
+Arena &Arena::ThreadArena()
+{
+    thread_local Arena arena;
+    threadArena = &arena;
+    return arena;
+}
+
+Arena *Arena::Current()
+{
+    return currentArena;
+}
+
+ArenaScope::ArenaScope() : previous_(currentArena), mark_(Arena::ThreadArena().GetMark())
+{
+    currentArena = &Arena::ThreadArena();
+    ++currentArena->scopes_;
+}
+
+ArenaScope::~ArenaScope()
+{
+    Arena &arena = Arena::ThreadArena();
+    --arena.scopes_;
+    arena.Rewind(mark_);
+    currentArena = previous_;
+}
+
+HeapScope::HeapScope() : previous_(currentArena)
+{
+    currentArena = nullptr;
+}
+
+HeapScope::~HeapScope()
+{
+    currentArena = previous_;
+}
+
+void *AllocateLimbs(std::size_t bytes)
+{
+    if (Arena *arena = currentArena)
+        return arena->Allocate(bytes);
+    return ::operator new(bytes);
+}
+
+void DeallocateLimbs(void *pointer, std::size_t bytes)
+{
+    if (pointer == nullptr)
+        return;
+    // Внутри ArenaScope освобождаются и буферы из кучи (числа, созданные до области или в HeapScope),
+    // поэтому владелец определяется по адресу
+    Arena *arena = threadArena;
+    if (arena != nullptr && arena->Owns(pointer))
+        arena->Deallocate(pointer, bytes);
+    else
+        ::operator delete(pointer);
+}
+
+} // namespace big_number
@@ -0,0 +1,185 @@
+#ifndef BIG_NUMBER_ARENA_HPP
+#define BIG_NUMBER_ARENA_HPP
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+namespace big_number
+{
+/// @brief Статистика арены
+struct ArenaStats
+{
+    std::size_t allocations = 0;    ///< Выделений из арены
+    std::size_t bytesAllocated = 0; ///< Байт выдано из арены (с учетом выравнивания)
+    std::size_t heapBlocks = 0;     ///< Блоков, запрошенных у кучи
+    std::size_t bytesReserved = 0;  ///< Байт во всех блоках арены
+    std::size_t peakBytes = 0;      ///< Наибольший занятый объем
+    std::size_t reused = 0;         ///< Выделений, обслуженных списками свободных буферов
+    std::size_t rewinds = 0;        ///< Откатов при выходе из ArenaScope
+};
+
+/// @brief Арена для промежуточных чисел
+///
+/// Память выдается последовательно из блоков, полученных у кучи; размер
+/// округляется вверх до степени двойки. Освобожденный последним буфер
+/// возвращается сдвигом позиции, остальные попадают в список свободных буферов
+/// своего размера и переиспользуются, поэтому циклы с временными числами не
+/// увеличивают занятый объем. Вся память возвращается откатом к отметке при
+/// выходе из ArenaScope. Блоки не освобождаются до уничтожения арены, поэтому
+/// после первого прохода алгоритм больше не обращается к куче.
+///
+/// У каждого потока своя арена (ThreadArena). Пока в потоке действует
+/// ArenaScope, коэффициенты всех BigNumber и рабочие буферы алгоритмов берутся
+/// из нее. Числа, созданные внутри области, не должны переживать ее и
+/// передаваться в другой поток: после отката их память выдается заново, и
+/// освобождение такого буфера испортило бы чужие числа. В отладочной сборке
+/// это проверяется при освобождении.
+class Arena
+{
+  public:
+    static constexpr std::size_t MIN_BLOCK_SIZE = 64 * 1024;           ///< Размер первого блока в байтах
+    static constexpr std::size_t ALIGNMENT = alignof(std::max_align_t); ///< Выравнивание выдаваемой памяти
+    static constexpr int SIZE_CLASSES = 64;                              ///< Списков свободных буферов (по степеням двойки)
+
+    /// @brief Позиция в арене для последующего отката
+    struct Mark
+    {
+        std::size_t block;
+        std::size_t offset;
+    };
+
+    Arena() = default;
+    Arena(const Arena &) = delete;
+    Arena &operator=(const Arena &) = delete;
+    ~Arena();
+
+    /// @brief Выделяет bytes байт с выравниванием ALIGNMENT
+    void *Allocate(std::size_t bytes);
+
+    /// @brief Освобождает буфер размера bytes, выделенный Allocate в еще открытой ArenaScope
+    void Deallocate(void *pointer, std::size_t bytes);
+
+    /// @brief Проверяет, принадлежит ли указатель блокам арены
+    bool Owns(const void *pointer) const;
+
+    /// @brief Текущая позиция
+    Mark GetMark() const;
+
+    /// @brief Откат к позиции: вся память, выданная после нее, считается свободной
+    void Rewind(Mark mark);
+
+    /// @brief Статистика с момента создания или последнего ResetStats
+    ArenaStats Stats() const;
+
+    /// @brief Обнуляет счетчики (кроме объема зарезервированных блоков)
+    void ResetStats();
+
+    /// @brief Арена текущего потока
+    static Arena &ThreadArena();
+
+    /// @brief Арена, установленная в текущем потоке, или nullptr вне ArenaScope
+    static Arena *Current();
+
+  private:
+    friend class ArenaScope;
+
+    struct Block
+    {
+        char *data;
+        std::size_t size;
+    };
+
+    // Переходит к следующему блоку, в котором помещается bytes, создавая его при необходимости
+    void NextBlock(std::size_t bytes);
+
+    // Лежит ли указатель до текущей позиции, то есть не был ли он освобожден откатом
+    bool IsLive(const void *pointer) const;
+
+    std::vector<Block> blocks_; ///< Блоки в порядке заполнения
+    std::size_t current_ = 0;   ///< Индекс заполняемого блока
+    std::size_t offset_ = 0;    ///< Занято байт в текущем блоке
+    std::size_t before_ = 0;    ///< Суммарный размер блоков до текущего
+    void *free_[SIZE_CLASSES] = {};  ///< Списки свободных буферов размера 2^i; ссылка на следующий хранится в буфере
+    int scopes_ = 0;                 ///< Открытых ArenaScope
+    ArenaStats stats_;
+};
+
+/// @brief Область действия арены текущего потока
+///
+/// На время жизни объекта выделения коэффициентов в потоке идут из арены;
+/// деструктор откатывает арену к состоянию на входе и восстанавливает
+/// предыдущую установку. Области могут быть вложенными.
+class ArenaScope
+{
+  public:
+    ArenaScope();
+    ArenaScope(const ArenaScope &) = delete;
+    ArenaScope &operator=(const ArenaScope &) = delete;
+    ~ArenaScope();
+
+  private:
+    Arena *previous_;
+    Arena::Mark mark_;
+};
+
+/// @brief Область, в которой выделения снова идут из кучи
+///
+/// Нужна для кэшей, которые заполняются внутри ArenaScope, но живут дольше нее.
+class HeapScope
+{
+  public:
+    HeapScope();
+    HeapScope(const HeapScope &) = delete;
+    HeapScope &operator=(const HeapScope &) = delete;
+    ~HeapScope();
+
+  private:
+    Arena *previous_;
+};
+
+/// @brief Выделяет память из установленной арены или из кучи вне ArenaScope
+void *AllocateLimbs(std::size_t bytes);
+
+/// @brief Освобождает память, выделенную AllocateLimbs
+void DeallocateLimbs(void *pointer, std::size_t bytes);
+
+/// @brief Аллокатор стандартных контейнеров поверх AllocateLimbs
+template <typename T> class ArenaAllocator
+{
+  public:
+    using value_type = T;
+    using Scope = ArenaScope; ///< Область, которую открывают обобщенные алгоритмы (generic_algorithms.hpp)
+
+    ArenaAllocator() = default;
+    template <typename U> ArenaAllocator(const ArenaAllocator<U> &)
+    {
+    }
+
+    T *allocate(std::size_t count)
+    {
+        return static_cast<T *>(AllocateLimbs(count * sizeof(T)));
+    }
+
+    void deallocate(T *pointer, std::size_t count)
+    {
+        DeallocateLimbs(pointer, count * sizeof(T));
+    }
+
+    template <typename U> bool operator==(const ArenaAllocator<U> &) const
+    {
+        return true;
+    }
+
+    template <typename U> bool operator!=(const ArenaAllocator<U> &) const
+    {
+        return false;
+    }
+};
+
+/// @brief Рабочий буфер алгоритма, память которого берется из арены
+template <typename T> using ScratchVector = std::vector<T, ArenaAllocator<T>>;
+
+} // namespace big_number
+
+#endif // BIG_NUMBER_ARENA_HPP
@@ -0,0 +1,97 @@
+#include "barrett.hpp"
+#include "limb_kernels.hpp"
+
+#include <algorithm>
+#include <vector>
+
+namespace big_number
+{
+template <typename Limb>
+BasicBarrettContext<Limb>::BasicBarrettContext(const BigNumber &modulus) : modulus_(modulus), k_(modulus.length_)
+{
+    if (modulus_.IsZero())
+        throw std::invalid_argument("The modulus must be a positive number.");
+
+    // mu = floor(b^(2k) / m)
+    BigNumber power(2 * k_ + 1);
+    power.coefficients_[2 * k_] = 1;
+    power.length_ = 2 * k_ + 1;
+    mu_ = power / modulus_;
+}
+
+template <typename Limb> const BasicBigNumber<Limb> &BasicBarrettContext<Limb>::Modulus() const
+{
+    return modulus_;
+}
+
+// HAC, алгоритм 14.42 с усеченным вычислением q2 (замечание 14.44)
+template <typename Limb> BasicBigNumber<Limb> BasicBarrettContext<Limb>::Reduce(const BigNumber &x) const
+{
+    if (x < modulus_)
+        return x;
+    if (x.length_ > 2 * k_)
+        return x % modulus_;
+
+    const BaseType *xs = x.coefficients_.data();
+    const BaseType *ms = modulus_.coefficients_.data();
+
+    // q2 = floor(x / b^(k-1)) * mu, нужны только коэффициенты начиная с k + 1. Частичные
+    // произведения q1[i] * mu[j] с i + j < k - 1 не вычисляются: их вклад меньше b^(k+1),
+    // поэтому q3 занижается не более чем на 1 и добавляется одно корректирующее вычитание.
+    // q2 хранится со сдвигом: q2[t] — коэффициент с номером k - 1 + t
+    const BaseType *q1 = xs + k_ - 1;
+    const int q1Length = x.length_ - (k_ - 1);
+    const BaseType *mu = mu_.coefficients_.data();
+    ScratchVector<BaseType> q2(q1Length + mu_.length_ - (k_ - 1), 0);
+    for (int i = 0; i < q1Length; ++i)
+    {
+        const int j = std::max(0, k_ - 1 - i);
+        if (j >= mu_.length_)
+            continue;
+        BaseType *row = q2.data() + (i + j - (k_ - 1));
+        row[mu_.length_ - j] = kernels::AddMul1(row, mu + j, mu_.length_ - j, q1[i]);
+    }
+    const BaseType *q3 = q2.data() + 2;
+    const int q3Length = std::max(0, static_cast<int>(q2.size()) - 2);
+
+    // r2 = (q3 * m) mod b^(k+1): усеченное умножение, старшие коэффициенты не вычисляются
+    const int width = k_ + 1;
+    ScratchVector<BaseType> r2(width, 0);
+    for (int i = 0; i < std::min(q3Length, width); ++i)
+    {
+        const BaseType carry = kernels::AddMul1(r2.data() + i, ms, std::min(k_, width - i), q3[i]);
+        if (i + k_ < width)
+            r2[i + k_] = carry;
+    }
+
+    // r = (x mod b^(k+1) - r2) mod b^(k+1)
+    BigNumber r(width);
+    BaseType *rs = r.coefficients_.data();
+    const int low = std::min(x.length_, width);
+    std::copy(xs, xs + low, rs);
+    std::fill(rs + low, rs + width, BaseType(0));
+    kernels::SubN(rs, rs, r2.data(), width);
+    r.length_ = width;
+    r.NormalizeLength();
+
+    // Не более трех корректирующих вычитаний
+    while (r >= modulus_)
+        r -= modulus_;
+    return r;
+}
+
+template <typename Limb>
+BasicBigNumber<Limb> BasicBarrettContext<Limb>::Multiply(const BigNumber &a, const BigNumber &b) const
+{
+    return Reduce(a * b);
+}
+
+template <typename Limb> BasicBigNumber<Limb> BasicBarrettContext<Limb>::Square(const BigNumber &a) const
+{
+    return Reduce(a * a);
+}
+
+template class BasicBarrettContext<std::uint32_t>;
+template class BasicBarrettContext<std::uint64_t>;
+
+} // namespace big_number
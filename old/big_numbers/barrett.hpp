@@ -0,0 +1,57 @@
+#ifndef BARRETT_HPP
+#define BARRETT_HPP
+
+#include "big_number.hpp"
+
+namespace big_number
+{
+/// @brief Контекст редукции Барретта для фиксированного модуля
+///
+/// При построении один раз вычисляется mu = floor(b^(2k) / m), где b = 2^BASE_SIZE —
+/// основание коэффициентов, k — длина модуля. После этого каждая редукция
+/// x < b^(2k) выполняется двумя усеченными умножениями (старшая часть q1 * mu
+/// и младшие k + 1 коэффициентов q3 * m) и не более чем тремя корректирующими
+/// вычитаниями, без деления.
+/// @tparam Limb Тип коэффициента: std::uint32_t или std::uint64_t
+template <typename Limb> class BasicBarrettContext
+{
+  public:
+    using BigNumber = BasicBigNumber<Limb>;
+    using BaseType = typename BigNumber::BaseType;
+
+    /// @brief Строит контекст для модуля
+    /// @param[in] modulus Модуль, больший нуля
+    /// @throw std::invalid_argument если модуль равен нулю
+    explicit BasicBarrettContext(const BigNumber &modulus);
+
+    /// @brief Модуль контекста
+    const BigNumber &Modulus() const;
+
+    /// @brief Вычисляет x mod m
+    ///
+    /// Для x длиннее 2k коэффициентов выполняется обычное деление.
+    /// @param[in] x Неотрицательное число
+    /// @return Остаток от деления x на модуль
+    BigNumber Reduce(const BigNumber &x) const;
+
+    /// @brief Вычисляет a * b mod m для a, b < m
+    BigNumber Multiply(const BigNumber &a, const BigNumber &b) const;
+
+    /// @brief Вычисляет a^2 mod m для a < m
+    BigNumber Square(const BigNumber &a) const;
+
+  private:
+    BigNumber modulus_; ///< Модуль m
+    BigNumber mu_;      ///< floor(b^(2k) / m), k + 1 коэффициент
+    int k_;             ///< Длина модуля в коэффициентах
+};
+
+using BarrettContext = BasicBarrettContext<std::uint64_t>;   ///< Контекст Барретта для BigNumber
+using BarrettContext32 = BasicBarrettContext<std::uint32_t>; ///< Контекст Барретта для BigNumber32
+
+extern template class BasicBarrettContext<std::uint32_t>;
+extern template class BasicBarrettContext<std::uint64_t>;
+
+} // namespace big_number
+
+#endif // BARRETT_HPP
@@ -1,11 +1,46 @@
 #include "big_number.hpp"
+#include "divisor.hpp"
+#include "limb_kernels.hpp"
+#include "multiplication.hpp"
+#include "radix_conversion.hpp"
 #include <sstream>
 
 namespace big_number
 {
+namespace
+{
+// Количество старших нулевых бит ненулевого коэффициента
+template <typename T> int CountLeadingZeroBits(T value)
+{
+    if constexpr (sizeof(T) <= sizeof(unsigned int))
+        return __builtin_clz(value) - static_cast<int>(sizeof(unsigned int) - sizeof(T)) * 8;
+    else
+        return __builtin_clzll(value);
+}
+
+// Количество младших нулевых бит ненулевого коэффициента
+template <typename T> int CountTrailingZeroBits(T value)
+{
+    if constexpr (sizeof(T) <= sizeof(unsigned int))
+        return __builtin_ctz(value);
+    else
+        return __builtin_ctzll(value);
+}
+
+// На little-endian платформе байты двоичной записи совпадают с коэффициентами в памяти
+constexpr bool LITTLE_ENDIAN_LIMBS = __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__;
+
+// Рабочая память деления для операторов / и %: своя у каждого потока
+template <typename Limb> BasicDivisionWorkspace<Limb> &ThreadDivisionWorkspace()
+{
+    thread_local BasicDivisionWorkspace<Limb> workspace;
+    return workspace;
+}
+} // namespace
 
 // Конструктор: если parameter не равен 0, записываем его в первый коэффициент
-BigNumber::BigNumber(int max_length, int parameter) : length_(1), maxLength_(max_length)
+template <typename Limb>
+BasicBigNumber<Limb>::BasicBigNumber(int max_length, int parameter) : length_(1), maxLength_(max_length)
 {
     coefficients_.resize(maxLength_, 0);
     if (parameter != 0)
@@ -15,21 +50,35 @@ BigNumber::BigNumber(int max_length, int parameter) : length_(1), maxLength_(max
 }
 
 // Конструктор копирования
-BigNumber::BigNumber(const BigNumber &other)
+template <typename Limb>
+BasicBigNumber<Limb>::BasicBigNumber(const BasicBigNumber &other)
     : coefficients_(other.coefficients_), length_(other.length_), maxLength_(other.maxLength_)
 {
 }
 
+// Конструктор перемещения: буфер забирается целиком, other становится нулем
+template <typename Limb>
+BasicBigNumber<Limb>::BasicBigNumber(BasicBigNumber &&other) noexcept
+    : coefficients_(std::move(other.coefficients_)), length_(other.length_), maxLength_(other.maxLength_)
+{
+    other.coefficients_.assign(1, 0);
+    other.length_ = 1;
+    other.maxLength_ = 1;
+}
+
 // Конструктор из строки (десятичное представление)
-BigNumber::BigNumber(const std::string &s)
-    : BigNumber(s.size()) // используем конструктор с max_length, приблизительно равным размеру строки
+template <typename Limb>
+BasicBigNumber<Limb>::BasicBigNumber(const std::string &s)
+    : BasicBigNumber(1, 0) // память под результат выделяет оператор ввода
 {
     std::istringstream iss(s);
     iss >> *this;
 }
 
 // Новый конструктор из числа
-BigNumber::BigNumber(unsigned long long value) : BigNumber(1, 0) // инициализируем нулём; maxLength_ изначально равен 1
+template <typename Limb>
+BasicBigNumber<Limb>::BasicBigNumber(unsigned long long value)
+    : BasicBigNumber(1, 0) // инициализируем нулём; maxLength_ изначально равен 1
 {
     // Очищаем вектор и заполняем коэффициенты, пока value > 0.
     coefficients_.clear();
@@ -41,12 +90,10 @@ BigNumber::BigNumber(unsigned long long value) : BigNumber(1, 0) // инициа
     }
     else
     {
-        DoubleBaseType base = static_cast<DoubleBaseType>(1) << BASE_SIZE;
         while (value > 0)
         {
-            BaseType coef = static_cast<BaseType>(value % base);
-            coefficients_.push_back(coef);
-            value /= base;
+            coefficients_.push_back(static_cast<BaseType>(value));
+            value = static_cast<unsigned long long>(static_cast<DoubleBaseType>(value) >> BASE_SIZE);
         }
         length_ = static_cast<int>(coefficients_.size());
         maxLength_ = length_;
@@ -54,23 +101,23 @@ BigNumber::BigNumber(unsigned long long value) : BigNumber(1, 0) // инициа
 }
 
 // Геттеры
-int BigNumber::GetLength()
+template <typename Limb> int BasicBigNumber<Limb>::GetLength()
 {
     return length_;
 }
 
-int BigNumber::GetMaxLength()
+template <typename Limb> int BasicBigNumber<Limb>::GetMaxLength()
 {
     return maxLength_;
 }
 
-BaseType *BigNumber::GetCoefficients()
+template <typename Limb> typename BasicBigNumber<Limb>::BaseType *BasicBigNumber<Limb>::GetCoefficients()
 {
     return coefficients_.data();
 }
 
 // Сеттеры
-void BigNumber::SetLength(int newLength)
+template <typename Limb> void BasicBigNumber<Limb>::SetLength(int newLength)
 {
     if (newLength > maxLength_)
     {
@@ -79,7 +126,7 @@ void BigNumber::SetLength(int newLength)
     length_ = newLength;
 }
 
-void BigNumber::SetMaxLength(int newMaxLength)
+template <typename Limb> void BasicBigNumber<Limb>::SetMaxLength(int newMaxLength)
 {
     if (newMaxLength < length_)
     {
@@ -89,7 +136,7 @@ void BigNumber::SetMaxLength(int newMaxLength)
     coefficients_.resize(maxLength_, 0);
 }
 
-void BigNumber::SetCoefficient(int index, BaseType value)
+template <typename Limb> void BasicBigNumber<Limb>::SetCoefficient(int index, BaseType value)
 {
     if (index >= 0 && index < length_)
     {
@@ -98,14 +145,14 @@ void BigNumber::SetCoefficient(int index, BaseType value)
 }
 
 // Удаляет незначащие нули (старшие коэффициенты, равные 0)
-void BigNumber::NormalizeLength()
+template <typename Limb> void BasicBigNumber<Limb>::NormalizeLength()
 {
     while (length_ > 1 && coefficients_[length_ - 1] == 0)
         --length_;
 }
 
 // Операторы сравнения
-bool BigNumber::operator==(const BigNumber &other) const
+template <typename Limb> bool BasicBigNumber<Limb>::operator==(const BasicBigNumber &other) const
 {
     if (length_ != other.length_)
         return false;
@@ -117,12 +164,12 @@ bool BigNumber::operator==(const BigNumber &other) const
     return true;
 }
 
-bool BigNumber::operator!=(const BigNumber &other) const
+template <typename Limb> bool BasicBigNumber<Limb>::operator!=(const BasicBigNumber &other) const
 {
     return !(*this == other);
 }
 
-bool BigNumber::operator<(const BigNumber &other) const
+template <typename Limb> bool BasicBigNumber<Limb>::operator<(const BasicBigNumber &other) const
 {
     if (length_ != other.length_)
         return length_ < other.length_;
@@ -134,23 +181,74 @@ bool BigNumber::operator<(const BigNumber &other) const
     return false;
 }
 
-bool BigNumber::operator>(const BigNumber &other) const
+template <typename Limb> bool BasicBigNumber<Limb>::operator>(const BasicBigNumber &other) const
 {
     return other < *this;
 }
 
-bool BigNumber::operator<=(const BigNumber &other) const
+template <typename Limb> bool BasicBigNumber<Limb>::operator<=(const BasicBigNumber &other) const
 {
     return !(*this > other);
 }
 
-bool BigNumber::operator>=(const BigNumber &other) const
+template <typename Limb> bool BasicBigNumber<Limb>::operator>=(const BasicBigNumber &other) const
 {
     return !(*this < other);
 }
 
+// Сравнения с коэффициентом: число длины больше 1 всегда больше любого коэффициента
+template <typename Limb> bool BasicBigNumber<Limb>::operator==(BaseType value) const
+{
+    return length_ == 1 && coefficients_[0] == value;
+}
+
+template <typename Limb> bool BasicBigNumber<Limb>::operator!=(BaseType value) const
+{
+    return !(*this == value);
+}
+
+template <typename Limb> bool BasicBigNumber<Limb>::operator<(BaseType value) const
+{
+    return length_ == 1 && coefficients_[0] < value;
+}
+
+template <typename Limb> bool BasicBigNumber<Limb>::operator>(BaseType value) const
+{
+    return length_ > 1 || coefficients_[0] > value;
+}
+
+template <typename Limb> bool BasicBigNumber<Limb>::operator<=(BaseType value) const
+{
+    return !(*this > value);
+}
+
+template <typename Limb> bool BasicBigNumber<Limb>::operator>=(BaseType value) const
+{
+    return !(*this < value);
+}
+
+template <typename Limb> bool BasicBigNumber<Limb>::IsZero() const
+{
+    return *this == BaseType(0);
+}
+
+template <typename Limb> bool BasicBigNumber<Limb>::IsOne() const
+{
+    return *this == BaseType(1);
+}
+
+template <typename Limb> bool BasicBigNumber<Limb>::IsEven() const
+{
+    return (coefficients_[0] & 1) == 0;
+}
+
+template <typename Limb> bool BasicBigNumber<Limb>::IsOdd() const
+{
+    return (coefficients_[0] & 1) != 0;
+}
+
 // Оператор присваивания
-BigNumber &BigNumber::operator=(const BigNumber &other)
+template <typename Limb> BasicBigNumber<Limb> &BasicBigNumber<Limb>::operator=(const BasicBigNumber &other)
 {
     if (this != &other)
     {
@@ -161,348 +259,496 @@ BigNumber &BigNumber::operator=(const BigNumber &other)
     return *this;
 }
 
-// Операция сложения
-BigNumber BigNumber::operator+(const BigNumber &other) const
+// Перемещающее присваивание
+template <typename Limb> BasicBigNumber<Limb> &BasicBigNumber<Limb>::operator=(BasicBigNumber &&other) noexcept
 {
-    int maxLen = std::max(length_, other.length_);
-    BigNumber result(maxLen + 1);
-    BaseType carry = 0;
-    int i = 0;
-    for (; i < std::min(length_, other.length_); ++i)
-    {
-        DoubleBaseType sum = static_cast<DoubleBaseType>(coefficients_[i]) + other.coefficients_[i] + carry;
-        result.coefficients_[i] = static_cast<BaseType>(sum);
-        carry = static_cast<BaseType>(sum >> BASE_SIZE);
-    }
-    while (i < length_)
-    {
-        DoubleBaseType sum = static_cast<DoubleBaseType>(coefficients_[i]) + carry;
-        result.coefficients_[i] = static_cast<BaseType>(sum);
-        carry = static_cast<BaseType>(sum >> BASE_SIZE);
-        ++i;
-    }
-    while (i < other.length_)
+    if (this != &other)
     {
-        DoubleBaseType sum = static_cast<DoubleBaseType>(other.coefficients_[i]) + carry;
-        result.coefficients_[i] = static_cast<BaseType>(sum);
-        carry = static_cast<BaseType>(sum >> BASE_SIZE);
-        ++i;
+        coefficients_ = std::move(other.coefficients_);
+        length_ = other.length_;
+        maxLength_ = other.maxLength_;
+        other.coefficients_.assign(1, 0);
+        other.length_ = 1;
+        other.maxLength_ = 1;
     }
-    result.coefficients_[maxLen] = carry;
+    return *this;
+}
+
+// Операция сложения
+template <typename Limb> BasicBigNumber<Limb> BasicBigNumber<Limb>::operator+(const BasicBigNumber &other) const
+{
+    const BasicBigNumber &longer = length_ >= other.length_ ? *this : other;
+    const BasicBigNumber &shorter = length_ >= other.length_ ? other : *this;
+    const int maxLen = longer.length_;
+    BasicBigNumber result(maxLen + 1);
+    result.coefficients_[maxLen] = kernels::Add(result.coefficients_.data(), longer.coefficients_.data(), maxLen,
+                                                shorter.coefficients_.data(), shorter.length_);
     result.length_ = maxLen + 1;
     result.NormalizeLength();
     return result;
 }
 
-BigNumber &BigNumber::operator+=(const BigNumber &other)
+// Сложение на месте: используется уже выделенная память, новая берется только под перенос
+template <typename Limb> BasicBigNumber<Limb> &BasicBigNumber<Limb>::operator+=(const BasicBigNumber &other)
 {
-    *this = *this + other;
+    const int otherLength = other.length_;
+    const int maxLen = std::max(length_, otherLength);
+    if (maxLength_ < maxLen + 1)
+    {
+        coefficients_.resize(maxLen + 1, 0);
+        maxLength_ = maxLen + 1;
+    }
+    for (int i = length_; i <= maxLen; ++i)
+        coefficients_[i] = 0;
+
+    // Данные other читаются после возможного перераспределения (other может совпадать с *this)
+    kernels::Add(coefficients_.data(), coefficients_.data(), maxLen + 1, other.coefficients_.data(), otherLength);
+    length_ = maxLen + 1;
+    NormalizeLength();
     return *this;
 }
 
 // Операция вычитания (предполагается, что *this >= other)
-BigNumber BigNumber::operator-(const BigNumber &other) const
+template <typename Limb> BasicBigNumber<Limb> BasicBigNumber<Limb>::operator-(const BasicBigNumber &other) const
 {
     if (*this < other)
         throw std::invalid_argument("Subtraction result would be negative.");
-    BigNumber result(length_);
-    int borrow = 0;
-    int i = 0;
-    for (; i < other.length_; ++i)
-    {
-        DoubleBaseType temp = (static_cast<DoubleBaseType>(1) << BASE_SIZE) | coefficients_[i];
-        temp = temp - other.coefficients_[i] - borrow;
-        result.coefficients_[i] = static_cast<BaseType>(temp);
-        borrow = (temp >> BASE_SIZE) ? 0 : 1;
-    }
-    while (i < length_)
-    {
-        DoubleBaseType temp = (static_cast<DoubleBaseType>(1) << BASE_SIZE) | coefficients_[i];
-        temp -= borrow;
-        result.coefficients_[i] = static_cast<BaseType>(temp);
-        borrow = (temp >> BASE_SIZE) ? 0 : 1;
-        ++i;
-    }
+    BasicBigNumber result(length_);
+    kernels::Sub(result.coefficients_.data(), coefficients_.data(), length_, other.coefficients_.data(), other.length_);
     result.length_ = length_;
     result.NormalizeLength();
     return result;
 }
 
-BigNumber &BigNumber::operator-=(const BigNumber &other)
+// Вычитание на месте (предполагается, что *this >= other)
+template <typename Limb> BasicBigNumber<Limb> &BasicBigNumber<Limb>::operator-=(const BasicBigNumber &other)
 {
-    *this = *this - other;
+    if (*this < other)
+        throw std::invalid_argument("Subtraction result would be negative.");
+    kernels::Sub(coefficients_.data(), coefficients_.data(), length_, other.coefficients_.data(), other.length_);
+    NormalizeLength();
     return *this;
 }
 
 // Умножение на скаляр
-BigNumber BigNumber::operator*(const BaseType &value) const
+template <typename Limb> BasicBigNumber<Limb> BasicBigNumber<Limb>::operator*(const BaseType &value) const
 {
-    BigNumber result(length_ + 1);
-    BaseType carry = 0;
-    int i = 0;
-    for (; i < length_; ++i)
-    {
-        DoubleBaseType prod = static_cast<DoubleBaseType>(coefficients_[i]) * value + carry;
-        result.coefficients_[i] = static_cast<BaseType>(prod);
-        carry = static_cast<BaseType>(prod >> BASE_SIZE);
-    }
-    result.coefficients_[i] = carry;
+    BasicBigNumber result(length_ + 1);
+    result.coefficients_[length_] = kernels::Mul1(result.coefficients_.data(), coefficients_.data(), length_, value);
     result.length_ = length_ + 1;
     result.NormalizeLength();
     return result;
 }
 
-BigNumber &BigNumber::operator*=(const BaseType &value)
+// Умножение на скаляр на месте
+template <typename Limb> BasicBigNumber<Limb> &BasicBigNumber<Limb>::operator*=(const BaseType &value)
 {
-    *this = *this * value;
+    if (maxLength_ < length_ + 1)
+    {
+        coefficients_.resize(length_ + 1, 0);
+        maxLength_ = length_ + 1;
+    }
+    coefficients_[length_] = kernels::Mul1(coefficients_.data(), coefficients_.data(), length_, value);
+    ++length_;
+    NormalizeLength();
     return *this;
 }
 
-// Умножение на большое число (школьный алгоритм)
-BigNumber BigNumber::operator*(const BigNumber &other) const
+// Умножение на большое число (школьный алгоритм, Карацуба, Тоом-3 или NTT в зависимости от длины)
+template <typename Limb> BasicBigNumber<Limb> BasicBigNumber<Limb>::operator*(const BasicBigNumber &other) const
 {
     if ((other.length_ == 1) && (other.coefficients_[0] == 0))
-        return BigNumber();
-    BigNumber result(length_ + other.length_);
-    for (int j = 0; j < other.length_; ++j)
-    {
-        if (other.coefficients_[j] != 0)
-        {
-            BaseType carry = 0;
-            for (int i = 0; i < length_; ++i)
-            {
-                DoubleBaseType prod = static_cast<DoubleBaseType>(coefficients_[i]) * other.coefficients_[j] +
-                                      result.coefficients_[i + j] + carry;
-                result.coefficients_[i + j] = static_cast<BaseType>(prod);
-                carry = static_cast<BaseType>(prod >> BASE_SIZE);
-            }
-            result.coefficients_[length_ + j] = carry;
-        }
-    }
+        return BasicBigNumber();
+    BasicBigNumber result(length_ + other.length_);
+    if (this == &other)
+        multiplication::Square(result.coefficients_.data(), coefficients_.data(), length_);
+    else
+        multiplication::Multiply(result.coefficients_.data(), coefficients_.data(), length_,
+                                 other.coefficients_.data(), other.length_);
     result.length_ = length_ + other.length_;
     result.NormalizeLength();
     return result;
 }
 
-BigNumber &BigNumber::operator*=(const BigNumber &other)
+template <typename Limb> BasicBigNumber<Limb> &BasicBigNumber<Limb>::operator*=(const BasicBigNumber &other)
 {
     *this = *this * other;
     return *this;
 }
 
-// Деление на скаляр
-BigNumber BigNumber::operator/(const BaseType &value) const
+// Деление на скаляр: аппаратное деление заменено умножением на обратную величину
+template <typename Limb> BasicBigNumber<Limb> BasicBigNumber<Limb>::operator/(const BaseType &value) const
 {
-    if (value == 0)
-        throw std::invalid_argument("Division by zero.");
-    BigNumber result(length_);
-    BaseType rem = 0;
-    for (int i = length_ - 1; i >= 0; --i)
+    // Степень двойки: сдвиг вместо деления
+    if (value != 0 && (value & (value - 1)) == 0)
+        return *this >> CountTrailingZeroBits(value);
+    BaseType remainder;
+    return BasicLimbDivisor<Limb>(value).Divide(*this, remainder);
+}
+
+// Остаток от деления на скаляр
+template <typename Limb> BasicBigNumber<Limb> BasicBigNumber<Limb>::operator%(const BaseType &value) const
+{
+    BasicBigNumber result(1);
+    if (value != 0 && (value & (value - 1)) == 0)
+        result.coefficients_[0] = coefficients_[0] & (value - 1); // степень двойки: маска младших бит
+    else
+        result.coefficients_[0] = BasicLimbDivisor<Limb>(value).Remainder(*this);
+    result.length_ = 1;
+    return result;
+}
+
+// Сдвиг влево: целые коэффициенты переносятся, остаток сдвига переходит в соседний коэффициент
+template <typename Limb> BasicBigNumber<Limb> BasicBigNumber<Limb>::operator<<(int shift) const
+{
+    if (shift < 0)
+        throw std::invalid_argument("Shift must be non-negative.");
+    if (length_ == 1 && coefficients_[0] == 0)
+        return BasicBigNumber();
+    const int limbShift = shift / BASE_SIZE;
+    const int bitShift = shift % BASE_SIZE;
+    BasicBigNumber result(length_ + limbShift + 1);
+    BaseType carry = 0;
+    for (int i = 0; i < length_; ++i)
     {
-        DoubleBaseType cur = (static_cast<DoubleBaseType>(rem) << BASE_SIZE) + coefficients_[i];
-        result.coefficients_[i] = static_cast<BaseType>(cur / value);
-        rem = static_cast<BaseType>(cur % value);
+        const BaseType word = coefficients_[i];
+        result.coefficients_[i + limbShift] = bitShift ? static_cast<BaseType>(word << bitShift) | carry : word;
+        carry = bitShift ? static_cast<BaseType>(word >> (BASE_SIZE - bitShift)) : 0;
     }
-    result.length_ = length_;
+    result.coefficients_[length_ + limbShift] = carry;
+    result.length_ = length_ + limbShift + 1;
     result.NormalizeLength();
     return result;
 }
 
-// Остаток от деления на скаляр
-BigNumber BigNumber::operator%(const BaseType &value) const
+template <typename Limb> BasicBigNumber<Limb> &BasicBigNumber<Limb>::operator<<=(int shift)
 {
-    if (value == 0)
-        throw std::invalid_argument("Division by zero.");
-    BaseType rem = 0;
-    for (int i = length_ - 1; i >= 0; --i)
+    *this = *this << shift;
+    return *this;
+}
+
+template <typename Limb> BasicBigNumber<Limb> BasicBigNumber<Limb>::operator>>(int shift) const
+{
+    BasicBigNumber result(*this);
+    result >>= shift;
+    return result;
+}
+
+// Сдвиг вправо на месте: коэффициенты читаются раньше, чем перезаписываются
+template <typename Limb> BasicBigNumber<Limb> &BasicBigNumber<Limb>::operator>>=(int shift)
+{
+    if (shift < 0)
+        throw std::invalid_argument("Shift must be non-negative.");
+    const int limbShift = shift / BASE_SIZE;
+    const int bitShift = shift % BASE_SIZE;
+    if (limbShift >= length_)
     {
-        DoubleBaseType cur = (static_cast<DoubleBaseType>(rem) << BASE_SIZE) + coefficients_[i];
-        rem = static_cast<BaseType>(cur % value);
+        coefficients_[0] = 0;
+        length_ = 1;
+        return *this;
     }
-    BigNumber result(1);
-    result.coefficients_[0] = rem;
-    result.length_ = 1;
+    const int newLength = length_ - limbShift;
+    for (int i = 0; i < newLength; ++i)
+    {
+        BaseType word = coefficients_[i + limbShift];
+        if (bitShift)
+        {
+            word >>= bitShift;
+            if (i + 1 < newLength)
+                word |= static_cast<BaseType>(coefficients_[i + limbShift + 1] << (BASE_SIZE - bitShift));
+        }
+        coefficients_[i] = word;
+    }
+    length_ = newLength;
+    NormalizeLength();
+    return *this;
+}
+
+template <typename Limb> BasicBigNumber<Limb> BasicBigNumber<Limb>::operator&(const BasicBigNumber &other) const
+{
+    BasicBigNumber result(*this);
+    result &= other;
     return result;
 }
 
-// -------------------------
-// Реализация алгоритма Кнута для деления (DivideKnuth)
-// -------------------------
-std::pair<BigNumber, BigNumber> BigNumber::DivideKnuth(const BigNumber &u_orig, const BigNumber &v_orig)
+template <typename Limb> BasicBigNumber<Limb> &BasicBigNumber<Limb>::operator&=(const BasicBigNumber &other)
 {
-    if ((v_orig.length_ == 1) && (v_orig.coefficients_[0] == 0))
-        throw std::invalid_argument("Division by zero.");
+    const int length = std::min(length_, other.length_);
+    for (int i = 0; i < length; ++i)
+        coefficients_[i] &= other.coefficients_[i];
+    length_ = length;
+    NormalizeLength();
+    return *this;
+}
+
+template <typename Limb> BasicBigNumber<Limb> BasicBigNumber<Limb>::operator|(const BasicBigNumber &other) const
+{
+    BasicBigNumber result(*this);
+    result |= other;
+    return result;
+}
+
+template <typename Limb> BasicBigNumber<Limb> &BasicBigNumber<Limb>::operator|=(const BasicBigNumber &other)
+{
+    const int otherLength = other.length_;
+    if (maxLength_ < otherLength)
+    {
+        coefficients_.resize(otherLength, 0);
+        maxLength_ = otherLength;
+    }
+    for (int i = length_; i < otherLength; ++i)
+        coefficients_[i] = 0;
+    const BaseType *rhs = other.coefficients_.data();
+    for (int i = 0; i < otherLength; ++i)
+        coefficients_[i] |= rhs[i];
+    length_ = std::max(length_, otherLength);
+    return *this;
+}
+
+template <typename Limb> BasicBigNumber<Limb> BasicBigNumber<Limb>::operator^(const BasicBigNumber &other) const
+{
+    BasicBigNumber result(*this);
+    result ^= other;
+    return result;
+}
 
-    if (u_orig < v_orig)
-        return {BigNumber(u_orig.maxLength_), u_orig};
+template <typename Limb> BasicBigNumber<Limb> &BasicBigNumber<Limb>::operator^=(const BasicBigNumber &other)
+{
+    const int otherLength = other.length_;
+    if (maxLength_ < otherLength)
+    {
+        coefficients_.resize(otherLength, 0);
+        maxLength_ = otherLength;
+    }
+    for (int i = length_; i < otherLength; ++i)
+        coefficients_[i] = 0;
+    const BaseType *rhs = other.coefficients_.data();
+    for (int i = 0; i < otherLength; ++i)
+        coefficients_[i] ^= rhs[i];
+    length_ = std::max(length_, otherLength);
+    NormalizeLength();
+    return *this;
+}
 
-    if (v_orig.length_ == 1)
-        return {u_orig / v_orig.coefficients_[0], u_orig % v_orig.coefficients_[0]};
+// Битовый доступ
+template <typename Limb> bool BasicBigNumber<Limb>::TestBit(int index) const
+{
+    if (index < 0)
+        throw std::invalid_argument("Bit index must be non-negative.");
+    if (index / BASE_SIZE >= length_)
+        return false;
+    return (coefficients_[index / BASE_SIZE] >> (index % BASE_SIZE)) & 1;
+}
 
-    int n = v_orig.length_;
-    int m = u_orig.length_ - n;
-    DoubleBaseType base = (static_cast<DoubleBaseType>(1) << BASE_SIZE);
+template <typename Limb> int BasicBigNumber<Limb>::BitLength() const
+{
+    const BaseType top = coefficients_[length_ - 1];
+    if (top == 0)
+        return 0;
+    return length_ * BASE_SIZE - CountLeadingZeroBits(top);
+}
 
-    BaseType d = static_cast<BaseType>(base / (v_orig.coefficients_[n - 1] + 1));
-    BigNumber u = u_orig * d;
-    BigNumber v = v_orig * d;
+template <typename Limb> int BasicBigNumber<Limb>::CountTrailingZeros() const
+{
+    for (int i = 0; i < length_; ++i)
+    {
+        if (coefficients_[i] != 0)
+            return i * BASE_SIZE + CountTrailingZeroBits(coefficients_[i]);
+    }
+    return 0;
+}
 
-    if (u.length_ == u_orig.length_)
+template <typename Limb> void BasicBigNumber<Limb>::Reserve(int length)
+{
+    if (maxLength_ < length)
     {
-        u.coefficients_.push_back(0);
-        u.length_++;
-        u.maxLength_++;
+        coefficients_.resize(length, 0);
+        maxLength_ = length;
     }
+}
+
+// -------------------------
+// Реализация алгоритма Кнута для деления (DivideKnuth)
+// -------------------------
+template <typename Limb>
+void BasicBigNumber<Limb>::DivideKnuth(const BasicBigNumber &u, const BasicBigNumber &v, BasicBigNumber &quotient,
+                                       BasicBigNumber &remainder, BasicDivisionWorkspace<Limb> &workspace)
+{
+    if ((v.length_ == 1) && (v.coefficients_[0] == 0))
+        throw std::invalid_argument("Division by zero.");
 
-    BigNumber Q(m + 1);
-    Q.length_ = m + 1;
+    if (u < v)
+    {
+        // Остаток записывается первым: quotient может совпадать с u
+        remainder = u;
+        quotient.coefficients_[0] = 0;
+        quotient.length_ = 1;
+        return;
+    }
 
-    for (int j = m; j >= 0; --j)
+    const int n = v.length_;
+    const int uLength = u.length_;
+    if (n == 1)
     {
-        DoubleBaseType numerator =
-            (static_cast<DoubleBaseType>(u.coefficients_[j + n]) << BASE_SIZE) + u.coefficients_[j + n - 1];
-        BaseType qhat = static_cast<BaseType>(numerator / v.coefficients_[n - 1]);
-        BaseType rhat = static_cast<BaseType>(numerator % v.coefficients_[n - 1]);
-
-        while ((qhat == static_cast<BaseType>(base)) ||
-               (static_cast<DoubleBaseType>(qhat) * v.coefficients_[n - 2] >
-                ((static_cast<DoubleBaseType>(rhat) << BASE_SIZE) + u.coefficients_[j + n - 2])))
+        const BasicLimbDivisor<Limb> divisor(v.coefficients_[0]);
+        quotient.Reserve(uLength);
+        const BaseType rem = divisor.Divide(quotient.coefficients_.data(), u.coefficients_.data(), uLength);
+        quotient.length_ = uLength;
+        quotient.NormalizeLength();
+        remainder.coefficients_[0] = rem;
+        remainder.length_ = 1;
+        return;
+    }
+
+    // Нормализованный делитель (старший бит равен 1) берется из кэша, если делитель не изменился
+    if (workspace.divisor_.size() != static_cast<std::size_t>(n) ||
+        !std::equal(workspace.divisor_.begin(), workspace.divisor_.end(), v.coefficients_.data()))
+    {
+        workspace.divisor_.assign(v.coefficients_.data(), v.coefficients_.data() + n);
+        workspace.shift_ = CountLeadingZeroBits(v.coefficients_[n - 1]);
+        workspace.normalized_.resize(n);
+        const int shift = workspace.shift_;
+        for (int i = n - 1; i > 0; --i)
         {
-            --qhat;
-            rhat += v.coefficients_[n - 1];
-            if (rhat >= base)
-                break;
+            workspace.normalized_[i] =
+                shift ? static_cast<BaseType>(v.coefficients_[i] << shift) | (v.coefficients_[i - 1] >> (BASE_SIZE - shift))
+                      : v.coefficients_[i];
         }
+        workspace.normalized_[0] = static_cast<BaseType>(v.coefficients_[0] << shift);
+        workspace.topDivisor_ = BasicTwoLimbDivisor<Limb>(workspace.normalized_[n - 1], workspace.normalized_[n - 2]);
+    }
+    const int shift = workspace.shift_;
+    const BaseType *vn = workspace.normalized_.data();
+
+    // Делимое сдвигается на тот же сдвиг; ему нужен дополнительный старший разряд un[m + n]
+    const int m = uLength - n;
+    workspace.dividend_.resize(uLength + 1);
+    BaseType *un = workspace.dividend_.data();
+    const BaseType *us = u.coefficients_.data();
+    un[uLength] = shift ? static_cast<BaseType>(us[uLength - 1] >> (BASE_SIZE - shift)) : 0;
+    for (int i = uLength - 1; i > 0; --i)
+        un[i] = shift ? static_cast<BaseType>(us[i] << shift) | (us[i - 1] >> (BASE_SIZE - shift)) : us[i];
+    un[0] = static_cast<BaseType>(us[0] << shift);
+
+    // u и v скопированы в workspace, поэтому quotient и remainder могут с ними совпадать
+    quotient.Reserve(m + 1);
+    BaseType *q = quotient.coefficients_.data();
+    const BasicTwoLimbDivisor<Limb> &topDivisor = workspace.topDivisor_;
 
-        int borrow = 0;
-        for (int i = 0; i < n; ++i)
+    for (int j = m; j >= 0; --j)
+    {
+        // Оценка частного делением трех старших разрядов остатка на два старших разряда делителя
+        // (Мёллер-Гранлунд, без аппаратного деления); оценка верна или больше верной на единицу
+        BaseType qhat = ~static_cast<BaseType>(0);
+        if (un[j + n] != vn[n - 1] || un[j + n - 1] != vn[n - 2])
         {
-            DoubleBaseType p = static_cast<DoubleBaseType>(qhat) * v.coefficients_[i];
-            int sub = static_cast<int>(u.coefficients_[j + i]) - static_cast<int>(p & (base - 1)) - borrow;
-            borrow = (sub < 0) ? 1 : 0;
-            u.coefficients_[j + i] = static_cast<BaseType>((sub + (borrow ? base : 0)) & (base - 1));
-            borrow += static_cast<int>(p >> BASE_SIZE);
+            BaseType r1, r0;
+            qhat = topDivisor.DivideStep(un[j + n], un[j + n - 1], un[j + n - 2], r1, r0);
         }
-        int sub = static_cast<int>(u.coefficients_[j + n]) - borrow;
-        if (sub < 0)
+
+        // Вычитание qhat * v из u[j .. j + n]
+        const BaseType borrow = kernels::SubMul1(un + j, vn, n, qhat);
+        const BaseType top = un[j + n];
+        un[j + n] = static_cast<BaseType>(top - borrow);
+
+        if (top < borrow)
         {
+            // qhat оказалось на единицу больше: возвращаем v обратно
             --qhat;
-            int carry = 0;
-            for (int i = 0; i < n; ++i)
-            {
-                int sum = static_cast<int>(u.coefficients_[j + i]) + static_cast<int>(v.coefficients_[i]) + carry;
-                if (sum >= static_cast<int>(base))
-                {
-                    sum -= static_cast<int>(base);
-                    carry = 1;
-                }
-                else
-                {
-                    carry = 0;
-                }
-                u.coefficients_[j + i] = static_cast<BaseType>(sum);
-            }
-            u.coefficients_[j + n] = static_cast<BaseType>(static_cast<int>(u.coefficients_[j + n]) + carry);
+            un[j + n] = static_cast<BaseType>(un[j + n] + kernels::AddN(un + j, un + j, vn, n));
         }
-        else
-        {
-            u.coefficients_[j + n] = static_cast<BaseType>(sub);
-        }
-        Q.coefficients_[j] = qhat;
+        q[j] = qhat;
     }
-    Q.NormalizeLength();
+    quotient.length_ = m + 1;
+    quotient.NormalizeLength();
 
-    BigNumber R(n);
-    R.length_ = n;
+    // Остаток — младшие n разрядов un, сдвинутые обратно
+    remainder.Reserve(n);
+    BaseType *r = remainder.coefficients_.data();
     for (int i = 0; i < n; ++i)
-        R.coefficients_[i] = u.coefficients_[i];
-    R = R / d;
-    R.NormalizeLength();
+        r[i] = shift ? (un[i] >> shift) | static_cast<BaseType>(un[i + 1] << (BASE_SIZE - shift)) : un[i];
+    remainder.length_ = n;
+    remainder.NormalizeLength();
+}
+
+template <typename Limb>
+std::pair<BasicBigNumber<Limb>, BasicBigNumber<Limb>> BasicBigNumber<Limb>::DivMod(const BasicBigNumber &divisor) const
+{
+    std::pair<BasicBigNumber, BasicBigNumber> result;
+    DivideKnuth(*this, divisor, result.first, result.second, ThreadDivisionWorkspace<Limb>());
+    return result;
+}
 
-    return {Q, R};
+template <typename Limb>
+void BasicBigNumber<Limb>::DivMod(const BasicBigNumber &divisor, BasicBigNumber &quotient, BasicBigNumber &remainder,
+                                  BasicDivisionWorkspace<Limb> &workspace) const
+{
+    DivideKnuth(*this, divisor, quotient, remainder, workspace);
 }
 
-BigNumber BigNumber::operator/(const BigNumber &other) const
+template <typename Limb> BasicBigNumber<Limb> BasicBigNumber<Limb>::operator/(const BasicBigNumber &other) const
 {
-    auto divRes = BigNumber::DivideKnuth(*this, other);
-    return divRes.first;
+    return DivMod(other).first;
 }
 
-BigNumber BigNumber::operator%(const BigNumber &other) const
+template <typename Limb> BasicBigNumber<Limb> BasicBigNumber<Limb>::operator%(const BasicBigNumber &other) const
 {
-    auto divRes = BigNumber::DivideKnuth(*this, other);
-    return divRes.second;
+    return DivMod(other).second;
 }
 
 // Оператор вывода в поток (вывод в десятичном виде)
-std::ostream &operator<<(std::ostream &out, const BigNumber number)
+template <typename Limb> std::ostream &operator<<(std::ostream &out, const BasicBigNumber<Limb> &number)
 {
-    BigNumber zero(1, 0);
-    if (number == zero)
-    {
-        out << "0";
-        return out;
-    }
-    BigNumber temp = number;
-    std::string str;
-    while (!(temp == zero))
-    {
-        BigNumber rem = temp % 10;
-        char digit = static_cast<char>(rem.coefficients_[0] + '0');
-        str.push_back(digit);
-        temp = temp / 10;
-    }
-    std::reverse(str.begin(), str.end());
-    out << str;
+    // Кэш степеней десяти переиспользуется между выводами в одном потоке
+    thread_local BasicDecimalConverter<Limb> converter;
+    out << converter.ToString(number);
     return out;
 }
 
 // Оператор ввода из потока (ожидается десятичное представление)
-std::istream &operator>>(std::istream &in, BigNumber &number)
+template <typename Limb> std::istream &operator>>(std::istream &in, BasicBigNumber<Limb> &number)
 {
+    thread_local BasicDecimalConverter<Limb> converter;
     std::string s;
     in >> s;
-    BigNumber result(s.size());
-    result = BigNumber(1, 0);
-    BigNumber ten(1, 10);
-    for (char ch : s)
-    {
-        if (ch < '0' || ch > '9')
-            throw std::invalid_argument("Invalid digit in input.");
-        result = result * 10;
-        BigNumber digit(1, ch - '0');
-        result = result + digit;
-    }
-    number = result;
+    number = converter.FromString(s);
     return in;
 }
 
-// Вывод числа в 16-ричной форме
-void BigNumber::PrintHex() const
+// Вывод числа в 16-ричной форме: вся строка собирается в буфере и выводится одной операцией
+template <typename Limb> void BasicBigNumber<Limb>::PrintHex() const
 {
+    static const char digits[] = "0123456789abcdef";
+    constexpr int limbDigits = BASE_SIZE / 4;
+    std::string out(static_cast<std::size_t>(length_) * (limbDigits + 1), ' ');
+    char *position = &out[0];
     for (int i = length_ - 1; i >= 0; --i)
     {
-        std::cout.width(BASE_SIZE / 4);
-        std::cout.fill('0');
-        std::cout << std::hex << coefficients_[i] << " ";
+        BaseType value = coefficients_[i];
+        for (int j = limbDigits - 1; j >= 0; --j)
+        {
+            position[j] = digits[value & 0xF];
+            value >>= 4;
+        }
+        position += limbDigits + 1;
     }
-    std::cout << std::dec;
+    std::cout << out;
 }
 
-// Чтение числа в 16-ричной форме
-void BigNumber::ReadHex()
+// Чтение числа в 16-ричной форме за один проход с младших цифр; пробелы между
+// коэффициентами (формат PrintHex) пропускаются
+template <typename Limb> void BasicBigNumber<Limb>::ReadHex()
 {
     std::string input;
     std::getline(std::cin, input);
-    int inputLength = input.size();
-    length_ = (inputLength - 1) / (BASE_SIZE / 4) + 1;
-    maxLength_ = length_;
-    coefficients_.assign(maxLength_, 0);
+    const int inputLength = static_cast<int>(input.size());
 
+    SmallLimbBuffer<BaseType, INLINE_LIMBS> coefficients;
+    coefficients.assign((inputLength - 1) / (BASE_SIZE / 4) + 1, 0);
     int k = 0, j = 0;
     for (int idx = inputLength - 1; idx >= 0; --idx)
     {
-        unsigned int temp = 0;
+        BaseType temp = 0;
         char ch = input[idx];
         if (ch >= '0' && ch <= '9')
             temp = ch - '0';
@@ -510,9 +756,11 @@ void BigNumber::ReadHex()
             temp = ch - 'a' + 10;
         else if (ch >= 'A' && ch <= 'F')
             temp = ch - 'A' + 10;
+        else if (ch == ' ' || ch == '\t' || ch == '\r')
+            continue;
         else
             throw std::invalid_argument("Invalid hexadecimal digit.");
-        coefficients_[j] |= temp << k;
+        coefficients[j] |= temp << k;
         k += 4;
         if (k >= BASE_SIZE)
         {
@@ -520,7 +768,95 @@ void BigNumber::ReadHex()
             ++j;
         }
     }
+    // Число изменяется только после успешного разбора всей строки
+    coefficients_ = std::move(coefficients);
+    maxLength_ = static_cast<int>(coefficients_.size());
+    length_ = maxLength_;
     NormalizeLength();
 }
 
+template <typename Limb> std::size_t BasicBigNumber<Limb>::SerializedSize() const
+{
+    return sizeof(std::uint64_t) * (1 + (BitLength() + 63) / 64);
+}
+
+template <typename Limb> std::size_t BasicBigNumber<Limb>::Serialize(unsigned char *buffer) const
+{
+    const std::uint64_t words = (BitLength() + 63) / 64;
+    for (std::size_t i = 0; i < sizeof(std::uint64_t); ++i)
+        buffer[i] = static_cast<unsigned char>(words >> (8 * i));
+
+    unsigned char *out = buffer + sizeof(std::uint64_t);
+    const std::size_t bytes = static_cast<std::size_t>(words) * sizeof(std::uint64_t);
+    const std::size_t limbBytes = std::min(bytes, static_cast<std::size_t>(length_) * sizeof(BaseType));
+    if (LITTLE_ENDIAN_LIMBS)
+    {
+        std::memcpy(out, coefficients_.data(), limbBytes);
+    }
+    else
+    {
+        for (std::size_t i = 0; i < limbBytes; ++i)
+            out[i] = static_cast<unsigned char>(coefficients_[i / sizeof(BaseType)] >> (8 * (i % sizeof(BaseType))));
+    }
+    // У 32-битных коэффициентов нечетной длины старшая половина последнего слова нулевая
+    std::fill(out + limbBytes, out + bytes, static_cast<unsigned char>(0));
+    return sizeof(std::uint64_t) + bytes;
+}
+
+template <typename Limb> std::vector<unsigned char> BasicBigNumber<Limb>::Serialize() const
+{
+    std::vector<unsigned char> buffer(SerializedSize());
+    Serialize(buffer.data());
+    return buffer;
+}
+
+template <typename Limb>
+std::size_t BasicBigNumber<Limb>::SerializedWords(const unsigned char *data, std::size_t size)
+{
+    if (size < sizeof(std::uint64_t))
+        throw std::invalid_argument("The serialized number is truncated.");
+    std::uint64_t words = 0;
+    for (std::size_t i = 0; i < sizeof(std::uint64_t); ++i)
+        words |= static_cast<std::uint64_t>(data[i]) << (8 * i);
+    if (words > (size - sizeof(std::uint64_t)) / sizeof(std::uint64_t))
+        throw std::invalid_argument("The serialized number is truncated.");
+    if (words > static_cast<std::uint64_t>(std::numeric_limits<int>::max() / (64 / BASE_SIZE)))
+        throw std::invalid_argument("The serialized number is too long.");
+    return static_cast<std::size_t>(words);
+}
+
+template <typename Limb>
+BasicBigNumber<Limb> BasicBigNumber<Limb>::Deserialize(const unsigned char *data, std::size_t size,
+                                                       std::size_t *consumed)
+{
+    const std::size_t words = SerializedWords(data, size);
+    const std::size_t bytes = words * sizeof(std::uint64_t);
+    const int length = std::max(static_cast<int>(words * (64 / BASE_SIZE)), 1);
+
+    BasicBigNumber number(length);
+    const unsigned char *in = data + sizeof(std::uint64_t);
+    if (LITTLE_ENDIAN_LIMBS)
+    {
+        std::memcpy(number.coefficients_.data(), in, bytes);
+    }
+    else
+    {
+        for (std::size_t i = 0; i < bytes; ++i)
+            number.coefficients_[i / sizeof(BaseType)] |= static_cast<BaseType>(in[i]) << (8 * (i % sizeof(BaseType)));
+    }
+    number.length_ = length;
+    number.NormalizeLength();
+    if (consumed != nullptr)
+        *consumed = sizeof(std::uint64_t) + bytes;
+    return number;
+}
+
+template class BasicBigNumber<std::uint32_t>;
+template class BasicBigNumber<std::uint64_t>;
+
+template std::ostream &operator<< <std::uint32_t>(std::ostream &out, const BasicBigNumber<std::uint32_t> &number);
+template std::ostream &operator<< <std::uint64_t>(std::ostream &out, const BasicBigNumber<std::uint64_t> &number);
+template std::istream &operator>> <std::uint32_t>(std::istream &in, BasicBigNumber<std::uint32_t> &number);
+template std::istream &operator>> <std::uint64_t>(std::istream &in, BasicBigNumber<std::uint64_t> &number);
+
 } // namespace big_number
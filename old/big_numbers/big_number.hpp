@@ -2,6 +2,7 @@
 #define BIG_NUMBER_HPP
 
 #include <algorithm>
+#include <cstdint>
 #include <cstring>
 #include <ctime>
 #include <iostream>
@@ -11,44 +12,170 @@
 #include <string>
 #include <vector>
 
+#include "limb_buffer.hpp"
+
 namespace big_number
 {
-using BaseType = unsigned char;               ///< Основной тип для хранения коэффициентов
-using DoubleBaseType = unsigned int;          ///< Тип для хранения удвоенных значений
-using FoursBaseType = unsigned long long int; ///< Тип для хранения учетверенных значений
+/// @brief Свойства типа коэффициента (лимба)
+/// @tparam Limb Беззнаковый тип коэффициента
+template <typename Limb> struct LimbTraits;
+
+template <> struct LimbTraits<std::uint32_t>
+{
+    using DoubleType = std::uint64_t; ///< Тип для хранения удвоенных значений
+};
 
-constexpr int BASE_SIZE = sizeof(BaseType) * 8;        ///< Размер BaseType в битах
-constexpr int DBASE_SIZE = sizeof(DoubleBaseType) * 8; ///< Размер DoubleBaseType в битах
-constexpr int QBASE_SIZE = sizeof(FoursBaseType) * 8;  ///< Размер FoursBaseType в битах
+template <> struct LimbTraits<std::uint64_t>
+{
+    using DoubleType = unsigned __int128; ///< Тип для хранения удвоенных значений
+};
+
+template <typename Limb> class BasicBigNumber;
+template <typename Limb> class BasicBigNumberView;
+template <typename Limb> class BasicBarrettContext;
+template <typename Limb> class BasicMontgomeryContext;
+template <typename Limb> class BasicDecimalConverter;
+template <typename Limb> class BasicDivisionWorkspace;
+template <typename Limb> class BasicLimbDivisor;
+
+template <typename Limb> std::istream &operator>>(std::istream &in, BasicBigNumber<Limb> &number);
+template <typename Limb> std::ostream &operator<<(std::ostream &out, const BasicBigNumber<Limb> &number);
+
+/// @brief Значение большого числа, вычисленное при компиляции
+///
+/// Литеральный тип: создается литералом _bn в constexpr-контексте и неявно
+/// преобразуется в BasicBigNumber копированием слов, без разбора строки.
+/// @tparam Words Количество 64-битных слов
+template <std::size_t Words> struct BigNumberConstant
+{
+    std::uint64_t words[Words]; ///< Слова значения (младшее слово имеет индекс 0)
+};
+
+/// @brief Разбирает запись целочисленного литерала при компиляции
+///
+/// Поддерживаются десятичная запись, 0x/0X, 0b/0B, восьмеричная с ведущим нулем
+/// и разделители разрядов '. Недопустимая цифра делает литерал ошибкой компиляции.
+/// @tparam Words Количество 64-битных слов результата
+/// @tparam Digits Символы литерала
+template <std::size_t Words, char... Digits> constexpr BigNumberConstant<Words> ParseBigNumberConstant()
+{
+    const char text[] = {Digits...};
+    const std::size_t length = sizeof...(Digits);
+    BigNumberConstant<Words> result{};
+    std::uint64_t base = 10;
+    std::size_t i = 0;
+    if (length > 1 && text[0] == '0' && (text[1] == 'x' || text[1] == 'X'))
+    {
+        base = 16;
+        i = 2;
+    }
+    else if (length > 1 && text[0] == '0' && (text[1] == 'b' || text[1] == 'B'))
+    {
+        base = 2;
+        i = 2;
+    }
+    else if (length > 1 && text[0] == '0')
+    {
+        base = 8;
+        i = 1;
+    }
+    for (; i < length; ++i)
+    {
+        const char ch = text[i];
+        if (ch == '\'')
+            continue;
+        const std::uint64_t digit = ch >= '0' && ch <= '9'   ? ch - '0'
+                                    : ch >= 'a' && ch <= 'f' ? ch - 'a' + 10
+                                    : ch >= 'A' && ch <= 'F' ? ch - 'A' + 10
+                                                             : base;
+        if (digit >= base)
+            throw std::invalid_argument("Invalid digit in input.");
+        unsigned __int128 carry = digit;
+        for (std::size_t w = 0; w < Words; ++w)
+        {
+            carry += static_cast<unsigned __int128>(result.words[w]) * base;
+            result.words[w] = static_cast<std::uint64_t>(carry);
+            carry >>= 64;
+        }
+    }
+    return result;
+}
+
+namespace literals
+{
+/// @brief Литерал большого числа: 12345678901234567890123_bn, 0xFFFF'FFFF'FFFF'FFFF'FFFF_bn
+///
+/// Значение вычисляется при компиляции; длина литерала не ограничена разрядностью
+/// unsigned long long.
+template <char... Digits> constexpr auto operator""_bn()
+{
+    // Не больше 4 бит на символ в любой из систем счисления
+    constexpr std::size_t words = (4 * sizeof...(Digits) + 63) / 64;
+    constexpr BigNumberConstant<words> value = ParseBigNumberConstant<words, Digits...>();
+    return value;
+}
+} // namespace literals
 
 /// @brief Класс для работы с большими числами на основе массива коэффициентов
-class BigNumber
+/// @tparam Limb Тип коэффициента: std::uint32_t или std::uint64_t
+template <typename Limb> class BasicBigNumber
 {
+  public:
+    using BaseType = Limb;                                        ///< Основной тип для хранения коэффициентов
+    using DoubleBaseType = typename LimbTraits<Limb>::DoubleType; ///< Тип для хранения удвоенных значений
+
+    static constexpr int BASE_SIZE = sizeof(BaseType) * 8;        ///< Размер BaseType в битах
+    static constexpr int DBASE_SIZE = sizeof(DoubleBaseType) * 8; ///< Размер DoubleBaseType в битах
+
+    static constexpr std::size_t INLINE_LIMBS = BIG_NUMBER_INLINE_LIMBS; ///< Коэффициентов без обращения к куче
+
+    template <typename> friend class BasicBarrettContext;
+    template <typename> friend class BasicMontgomeryContext;
+    template <typename> friend class BasicDecimalConverter;
+    template <typename> friend class BasicLimbDivisor;
+    template <typename> friend class BasicBigNumberView;
+
   protected:
-    std::vector<BaseType> coefficients_; ///< Коэффициенты числа (младший разряд имеет индекс 0)
-    int length_;                         ///< Фактическая длина числа (количество значащих коэффициентов)
-    int maxLength_;                      ///< Максимально возможная длина массива коэффициентов
+    SmallLimbBuffer<BaseType, INLINE_LIMBS> coefficients_; ///< Коэффициенты числа (младший разряд имеет индекс 0)
+    int length_;    ///< Фактическая длина числа (количество значащих коэффициентов)
+    int maxLength_; ///< Максимально возможная длина массива коэффициентов
 
   public:
     /// @brief Конструктор, создающий число с заданной максимальной длиной и начальным значением
     /// @param[in] max_length Максимальная длина числа
     /// @param[in] parameter Начальное значение (записывается в первый коэффициент, остальные – 0)
-    explicit BigNumber(int max_length = 1, int parameter = 0);
+    explicit BasicBigNumber(int max_length = 1, int parameter = 0);
 
     /// @brief Конструктор копирования
     /// @param[in] other Объект для копирования
-    BigNumber(const BigNumber &other);
+    BasicBigNumber(const BasicBigNumber &other);
+
+    /// @brief Конструктор перемещения
+    /// @param[in,out] other Объект, из которого забираются коэффициенты (становится нулем)
+    BasicBigNumber(BasicBigNumber &&other) noexcept;
 
     /// @brief Конструктор из строки (десятичное представление числа)
     /// @param[in] s Строка с десятичным представлением числа
-    explicit BigNumber(const std::string &s);
+    explicit BasicBigNumber(const std::string &s);
 
     /// @brief Конструктор из числа (unsigned long long)
     /// @param[in] value Число, которое необходимо представить в виде BigNumber
-    explicit BigNumber(unsigned long long value);
+    explicit BasicBigNumber(unsigned long long value);
+
+    /// @brief Конструктор из константы, вычисленной при компиляции (литерал _bn)
+    /// @param[in] constant Значение числа
+    template <std::size_t Words>
+    BasicBigNumber(const BigNumberConstant<Words> &constant)
+        : length_(static_cast<int>(Words * (64 / BASE_SIZE))), maxLength_(length_)
+    {
+        coefficients_.resize(maxLength_, 0);
+        for (int i = 0; i < length_; ++i)
+            coefficients_[i] = static_cast<BaseType>(constant.words[i * BASE_SIZE / 64] >> (i * BASE_SIZE % 64));
+        NormalizeLength();
+    }
 
     /// @brief Деструктор
-    ~BigNumber() = default;
+    ~BasicBigNumber() = default;
 
     /// @brief Получает фактическую длину числа
     /// @return Количество значащих коэффициентов
@@ -83,102 +210,226 @@ class BigNumber
     /// @brief Оператор сравнения на равенство
     /// @param[in] other Число для сравнения
     /// @return true, если числа равны, иначе false
-    bool operator==(const BigNumber &other) const;
+    bool operator==(const BasicBigNumber &other) const;
 
     /// @brief Оператор сравнения на неравенство
     /// @param[in] other Число для сравнения
     /// @return true, если числа не равны, иначе false
-    bool operator!=(const BigNumber &other) const;
+    bool operator!=(const BasicBigNumber &other) const;
 
     /// @brief Оператор сравнения "меньше"
     /// @param[in] other Число для сравнения
     /// @return true, если текущее число меньше, иначе false
-    bool operator<(const BigNumber &other) const;
+    bool operator<(const BasicBigNumber &other) const;
 
     /// @brief Оператор сравнения "больше"
     /// @param[in] other Число для сравнения
     /// @return true, если текущее число больше, иначе false
-    bool operator>(const BigNumber &other) const;
+    bool operator>(const BasicBigNumber &other) const;
 
     /// @brief Оператор сравнения "меньше или равно"
     /// @param[in] other Число для сравнения
     /// @return true, если текущее число меньше или равно, иначе false
-    bool operator<=(const BigNumber &other) const;
+    bool operator<=(const BasicBigNumber &other) const;
 
     /// @brief Оператор сравнения "больше или равно"
     /// @param[in] other Число для сравнения
     /// @return true, если текущее число больше или равно, иначе false
-    bool operator>=(const BigNumber &other) const;
+    bool operator>=(const BasicBigNumber &other) const;
+
+    /// @brief Сравнение с коэффициентом без построения временного числа
+    /// @param[in] value Значение для сравнения
+    /// @return true, если число равно value
+    bool operator==(BaseType value) const;
+
+    /// @brief Сравнение с коэффициентом на неравенство
+    bool operator!=(BaseType value) const;
+
+    /// @brief Сравнение с коэффициентом "меньше"
+    bool operator<(BaseType value) const;
+
+    /// @brief Сравнение с коэффициентом "больше"
+    bool operator>(BaseType value) const;
+
+    /// @brief Сравнение с коэффициентом "меньше или равно"
+    bool operator<=(BaseType value) const;
+
+    /// @brief Сравнение с коэффициентом "больше или равно"
+    bool operator>=(BaseType value) const;
+
+    /// @brief Проверка на ноль
+    bool IsZero() const;
+
+    /// @brief Проверка на единицу
+    bool IsOne() const;
+
+    /// @brief Проверка на четность (x % 2 == 0 без деления)
+    bool IsEven() const;
+
+    /// @brief Проверка на нечетность
+    bool IsOdd() const;
 
     /// @brief Оператор присваивания
     /// @param[in] other Число для присваивания
     /// @return Ссылка на текущее число
-    BigNumber &operator=(const BigNumber &other);
+    BasicBigNumber &operator=(const BasicBigNumber &other);
+
+    /// @brief Оператор перемещающего присваивания
+    /// @param[in,out] other Объект, из которого забираются коэффициенты (становится нулем)
+    /// @return Ссылка на текущее число
+    BasicBigNumber &operator=(BasicBigNumber &&other) noexcept;
 
     /// @brief Оператор сложения
     /// @param[in] other Число для сложения
     /// @return Результат сложения
-    BigNumber operator+(const BigNumber &other) const;
+    BasicBigNumber operator+(const BasicBigNumber &other) const;
 
     /// @brief Оператор сложения с присваиванием
     /// @param[in] other Число для сложения
     /// @return Ссылка на текущее число
-    BigNumber &operator+=(const BigNumber &other);
+    BasicBigNumber &operator+=(const BasicBigNumber &other);
 
     /// @brief Оператор вычитания
     /// @param[in] other Число для вычитания
     /// @return Результат вычитания
     /// @throw std::invalid_argument если результат вычитания будет отрицательным
-    BigNumber operator-(const BigNumber &other) const;
+    BasicBigNumber operator-(const BasicBigNumber &other) const;
 
     /// @brief Оператор вычитания с присваиванием
     /// @param[in] other Число для вычитания
     /// @return Ссылка на текущее число
-    BigNumber &operator-=(const BigNumber &other);
+    BasicBigNumber &operator-=(const BasicBigNumber &other);
 
     /// @brief Оператор умножения на скаляр
     /// @param[in] value Скаляр для умножения
     /// @return Результат умножения
-    BigNumber operator*(const BaseType &value) const;
+    BasicBigNumber operator*(const BaseType &value) const;
 
     /// @brief Оператор умножения на скаляр с присваиванием
     /// @param[in] value Скаляр для умножения
     /// @return Ссылка на текущее число
-    BigNumber &operator*=(const BaseType &value);
+    BasicBigNumber &operator*=(const BaseType &value);
 
     /// @brief Оператор умножения на большое число
     /// @param[in] other Число для умножения
     /// @return Результат умножения
-    BigNumber operator*(const BigNumber &other) const;
+    BasicBigNumber operator*(const BasicBigNumber &other) const;
 
     /// @brief Оператор умножения на большое число с присваиванием
     /// @param[in] other Число для умножения
     /// @return Ссылка на текущее число
-    BigNumber &operator*=(const BigNumber &other);
+    BasicBigNumber &operator*=(const BasicBigNumber &other);
 
     /// @brief Оператор деления на скаляр
     /// @param[in] value Скаляр для деления
     /// @return Результат деления
     /// @throw std::invalid_argument если деление на ноль
-    BigNumber operator/(const BaseType &value) const;
+    BasicBigNumber operator/(const BaseType &value) const;
 
     /// @brief Оператор остатка от деления на скаляр
     /// @param[in] value Скаляр для деления
     /// @return Остаток от деления
     /// @throw std::invalid_argument если деление на ноль
-    BigNumber operator%(const BaseType &value) const;
+    BasicBigNumber operator%(const BaseType &value) const;
 
     /// @brief Оператор деления на большое число
     /// @param[in] other Число для деления
     /// @return Результат деления
     /// @throw std::invalid_argument если деление на ноль
-    BigNumber operator/(const BigNumber &other) const;
+    BasicBigNumber operator/(const BasicBigNumber &other) const;
 
     /// @brief Оператор остатка от деления на большое число
     /// @param[in] other Число для деления
     /// @return Остаток от деления
     /// @throw std::invalid_argument если деление на ноль
-    BigNumber operator%(const BigNumber &other) const;
+    BasicBigNumber operator%(const BasicBigNumber &other) const;
+
+    /// @brief Деление с остатком за один проход
+    /// @param[in] divisor Делитель
+    /// @return Пара из частного и остатка
+    /// @throw std::invalid_argument если деление на ноль
+    std::pair<BasicBigNumber, BasicBigNumber> DivMod(const BasicBigNumber &divisor) const;
+
+    /// @brief Деление с остатком в заранее выделенную память
+    ///
+    /// Частное и остаток записываются в переданные числа с переиспользованием их
+    /// памяти; нормализованный делитель кэшируется в workspace, поэтому повторные
+    /// деления на тот же делитель не нормализуют его заново и не выделяют память.
+    /// @param[in] divisor Делитель
+    /// @param[out] quotient Частное (может совпадать с *this или divisor)
+    /// @param[out] remainder Остаток (может совпадать с *this или divisor, но не с quotient)
+    /// @param[in,out] workspace Рабочая память деления (объявлена в divisor.hpp)
+    /// @throw std::invalid_argument если деление на ноль
+    void DivMod(const BasicBigNumber &divisor, BasicBigNumber &quotient, BasicBigNumber &remainder,
+                BasicDivisionWorkspace<Limb> &workspace) const;
+
+    /// @brief Сдвиг влево на заданное число бит (умножение на 2^shift)
+    /// @param[in] shift Величина сдвига в битах
+    /// @return Результат сдвига
+    /// @throw std::invalid_argument если сдвиг отрицательный
+    BasicBigNumber operator<<(int shift) const;
+
+    /// @brief Сдвиг влево с присваиванием
+    /// @param[in] shift Величина сдвига в битах
+    /// @return Ссылка на текущее число
+    /// @throw std::invalid_argument если сдвиг отрицательный
+    BasicBigNumber &operator<<=(int shift);
+
+    /// @brief Сдвиг вправо на заданное число бит (деление на 2^shift с округлением вниз)
+    /// @param[in] shift Величина сдвига в битах
+    /// @return Результат сдвига
+    /// @throw std::invalid_argument если сдвиг отрицательный
+    BasicBigNumber operator>>(int shift) const;
+
+    /// @brief Сдвиг вправо с присваиванием (выполняется на месте)
+    /// @param[in] shift Величина сдвига в битах
+    /// @return Ссылка на текущее число
+    /// @throw std::invalid_argument если сдвиг отрицательный
+    BasicBigNumber &operator>>=(int shift);
+
+    /// @brief Побитовое И
+    /// @param[in] other Второй операнд
+    /// @return Результат операции
+    BasicBigNumber operator&(const BasicBigNumber &other) const;
+
+    /// @brief Побитовое И с присваиванием
+    /// @param[in] other Второй операнд
+    /// @return Ссылка на текущее число
+    BasicBigNumber &operator&=(const BasicBigNumber &other);
+
+    /// @brief Побитовое ИЛИ
+    /// @param[in] other Второй операнд
+    /// @return Результат операции
+    BasicBigNumber operator|(const BasicBigNumber &other) const;
+
+    /// @brief Побитовое ИЛИ с присваиванием
+    /// @param[in] other Второй операнд
+    /// @return Ссылка на текущее число
+    BasicBigNumber &operator|=(const BasicBigNumber &other);
+
+    /// @brief Побитовое исключающее ИЛИ
+    /// @param[in] other Второй операнд
+    /// @return Результат операции
+    BasicBigNumber operator^(const BasicBigNumber &other) const;
+
+    /// @brief Побитовое исключающее ИЛИ с присваиванием
+    /// @param[in] other Второй операнд
+    /// @return Ссылка на текущее число
+    BasicBigNumber &operator^=(const BasicBigNumber &other);
+
+    /// @brief Проверяет бит с заданным номером
+    /// @param[in] index Номер бита (0 — младший)
+    /// @return true, если бит установлен; биты за пределами числа равны 0
+    /// @throw std::invalid_argument если номер отрицательный
+    bool TestBit(int index) const;
+
+    /// @brief Длина числа в битах
+    /// @return Номер старшего единичного бита плюс один; 0 для нуля
+    int BitLength() const;
+
+    /// @brief Количество младших нулевых бит
+    /// @return Наибольшее k, при котором число делится на 2^k; 0 для нуля
+    int CountTrailingZeros() const;
 
     /// @brief Вывод числа в 16-ричной системе
     void PrintHex() const;
@@ -186,37 +437,80 @@ class BigNumber
     /// @brief Чтение числа в 16-ричной системе
     void ReadHex();
 
+    /// @brief Размер двоичной записи числа в байтах (см. Serialize)
+    std::size_t SerializedSize() const;
+
+    /// @brief Запись числа в компактном двоичном формате
+    ///
+    /// Формат: число слов w, затем w слов числа от младшего к старшему; все слова
+    /// 64-битные little-endian, старшее слово ненулевое (у нуля w = 0). Запись не
+    /// зависит от типа коэффициента, а на little-endian платформе слова совпадают
+    /// с массивом коэффициентов, поэтому запись читается без копирования через
+    /// BasicBigNumberView::FromSerialized.
+    /// @param[out] buffer Буфер не меньше SerializedSize() байт
+    /// @return Количество записанных байт
+    std::size_t Serialize(unsigned char *buffer) const;
+
+    /// @brief Запись числа в компактном двоичном формате в новый буфер
+    /// @return Байты записи
+    std::vector<unsigned char> Serialize() const;
+
+    /// @brief Чтение числа из двоичного формата (см. Serialize)
+    /// @param[in] data Начало записи
+    /// @param[in] size Доступно байт
+    /// @param[out] consumed Размер записи в байтах (если не nullptr)
+    /// @return Прочитанное число
+    /// @throw std::invalid_argument если запись обрезана или слишком длинная
+    static BasicBigNumber Deserialize(const unsigned char *data, std::size_t size, std::size_t *consumed = nullptr);
+
+    /// @brief Проверяет заголовок двоичной записи
+    /// @param[in] data Начало записи
+    /// @param[in] size Доступно байт
+    /// @return Количество 64-битных слов числа
+    /// @throw std::invalid_argument если запись обрезана или слишком длинная
+    static std::size_t SerializedWords(const unsigned char *data, std::size_t size);
+
     /// @brief Оператор ввода из потока
     /// @param[in,out] in Входной поток
     /// @param[out] number Число для ввода
     /// @return Входной поток
-    friend std::istream &operator>>(std::istream &in, BigNumber &number);
+    friend std::istream &big_number::operator>> <>(std::istream &in, BasicBigNumber &number);
 
     /// @brief Оператор вывода в поток (вывод в десятичном виде)
     /// @param[in,out] out Выходной поток
     /// @param[in] number Число для вывода
     /// @return Выходной поток
-    friend std::ostream &operator<<(std::ostream &out, const BigNumber number);
+    friend std::ostream &big_number::operator<< <>(std::ostream &out, const BasicBigNumber &number);
 
-    /// @brief Быстрое возведение в квадрат на основе алгоритма с оптимизацией
+    /// @brief Быстрое возведение в квадрат
+    ///
+    /// Недиагональные произведения вычисляются один раз и удваиваются сдвигом;
+    /// примерно в полтора раза быстрее умножения числа на его копию.
     /// @return Результат возведения в квадрат
-    BigNumber FastSquare();
+    BasicBigNumber FastSquare() const;
 
     /// @brief Дихотомический алгоритм возведения в степень
     /// @param[in] number Число для возведения в степень
     /// @return Результат возведения в степень
-    BigNumber DichatomicExponentiation(const BigNumber &number) const;
+    BasicBigNumber DichatomicExponentiation(const BasicBigNumber &number) const;
 
     /// @brief Алгоритм Барретта
     /// @param[in] number Число для алгоритма Барретта
     /// @return Результат алгоритма Барретта
-    BigNumber BarretAlgo(const BigNumber &number) const;
-
-    /// @brief Генерирует случайное БЧ в диапазоне
+    BasicBigNumber BarretAlgo(const BasicBigNumber &number) const;
+
+    /// @brief Генерирует случайное БЧ, равномерно распределенное в диапазоне [startValue, endValue]
+    ///
+    /// Коэффициенты заполняются за один проход генератором текущего потока
+    /// (RandomEngine::ThreadEngine), старший коэффициент обрезается маской до длины
+    /// endValue - startValue; значения больше нее отбрасываются (в среднем меньше
+    /// двух попыток). Можно вызывать из нескольких потоков одновременно.
+    /// @param length Не используется, оставлен для совместимости
     /// @param startValue нижняя граница диапазона
     /// @param endValue верхняя граница диапазона
     /// @return Сгенерированное БЧ
-    BigNumber Generator(int length, BigNumber startValue, BigNumber endValue);
+    /// @throw std::invalid_argument если endValue < startValue
+    static BasicBigNumber Generator(int length, const BasicBigNumber &startValue, const BasicBigNumber &endValue);
 
     /// @brief Тест на простоту числа по Ферма
     /// @param number БЧ
@@ -233,22 +527,53 @@ class BigNumber
     /// @return True, если простое
     bool SoloveyStrassenTest(size_t reliabilityParameter);
 
-    // Модульное возведение в степень
-    BigNumber ModularExponentiation(const BigNumber &exponent, const BigNumber &modulus) const;
-
-    // Преобразование числа в двоичный вид (вспомогательный метод)
+    /// @brief Модульное возведение в степень скользящим окном слева направо
+    ///
+    /// Для нечетного модуля используется арифметика Монтгомери, для четного — редукция Барретта.
+    /// @param exponent Показатель (может быть нулевым)
+    /// @param modulus Положительный модуль
+    /// @return this^exponent mod modulus
+    /// @throw std::invalid_argument если модуль равен нулю
+    BasicBigNumber ModularExponentiation(const BasicBigNumber &exponent, const BasicBigNumber &modulus) const;
+
+    /// @brief Модульное возведение в степень для чисел во внешних буферах
+    ///
+    /// Биты показателя читаются прямо из представления; основание и модуль
+    /// копируются только в рабочие таблицы алгоритма.
+    /// @param base Основание
+    /// @param exponent Показатель (может быть нулевым)
+    /// @param modulus Положительный модуль
+    /// @return base^exponent mod modulus
+    /// @throw std::invalid_argument если модуль равен нулю
+    static BasicBigNumber ModularExponentiation(const BasicBigNumberView<Limb> &base,
+                                                const BasicBigNumberView<Limb> &exponent,
+                                                const BasicBigNumberView<Limb> &modulus);
+
+    /// @brief Преобразование числа в двоичный вид
+    /// @return Биты числа, начиная со старшего; пустой вектор для нуля
     std::vector<bool> ToBinary() const;
 
   private:
-    // Статическая вспомогательная функция деления по алгоритму Кнута,
-    // которая имеет доступ к защищённым членам класса.
-    /// @param[in] u_orig Делимое
-    /// @param[in] v_orig Делитель
-    /// @return Пара из частного и остатка
+    // Расширяет массив коэффициентов до length без сохранения значения числа
+    void Reserve(int length);
+
+    // Деление по алгоритму Кнута (TAOCP, том 2, алгоритм D) в память workspace
+    /// @param[in] u Делимое
+    /// @param[in] v Делитель
+    /// @param[out] quotient Частное
+    /// @param[out] remainder Остаток
+    /// @param[in,out] workspace Рабочая память с кэшем нормализованного делителя
     /// @throw std::invalid_argument если деление на ноль
-    static std::pair<BigNumber, BigNumber> DivideKnuth(const BigNumber &u_orig, const BigNumber &v_orig);
+    static void DivideKnuth(const BasicBigNumber &u, const BasicBigNumber &v, BasicBigNumber &quotient,
+                            BasicBigNumber &remainder, BasicDivisionWorkspace<Limb> &workspace);
 };
 
+using BigNumber = BasicBigNumber<std::uint64_t>;   ///< Большое число с 64-битными коэффициентами (по умолчанию)
+using BigNumber32 = BasicBigNumber<std::uint32_t>; ///< Большое число с 32-битными коэффициентами
+
+extern template class BasicBigNumber<std::uint32_t>;
+extern template class BasicBigNumber<std::uint64_t>;
+
 } // namespace big_number
 
 #endif // BIG_NUMBER_HPP
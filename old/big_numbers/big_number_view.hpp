@@ -0,0 +1,193 @@
+#ifndef BIG_NUMBER_VIEW_HPP
+#define BIG_NUMBER_VIEW_HPP
+
+#include "big_number.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+
+namespace big_number
+{
+/// @brief Невладеющее представление большого числа во внешнем массиве коэффициентов
+///
+/// Хранит только указатель и длину, поэтому число из отображенного в память
+/// файла или сетевого буфера читается без копирования. Коэффициенты идут от
+/// младшего к старшему, как в BasicBigNumber; старшие нули отбрасываются при
+/// построении. BasicBigNumber неявно преобразуется в представление, поэтому
+/// функции, принимающие представление (сравнения, ModularExponentiation,
+/// generic::Jacobi), принимают и обычные числа. Буфер должен жить дольше
+/// представления и не изменяться, пока оно используется.
+/// @tparam Limb Тип коэффициента: std::uint32_t или std::uint64_t
+template <typename Limb> class BasicBigNumberView
+{
+  public:
+    using BigNumber = BasicBigNumber<Limb>;
+    using BaseType = Limb;
+
+    static constexpr int BASE_SIZE = BigNumber::BASE_SIZE; ///< Размер BaseType в битах
+
+    /// @brief Представление нуля
+    BasicBigNumberView() : limbs_(nullptr), length_(0)
+    {
+    }
+
+    /// @brief Представление внешнего массива коэффициентов
+    /// @param[in] limbs Коэффициенты от младшего к старшему
+    /// @param[in] length Количество коэффициентов
+    /// @throw std::invalid_argument если длина отрицательная
+    BasicBigNumberView(const BaseType *limbs, int length) : limbs_(limbs), length_(length)
+    {
+        if (length < 0)
+            throw std::invalid_argument("The view length must be non-negative.");
+        while (length_ > 0 && limbs_[length_ - 1] == 0)
+            --length_;
+    }
+
+    /// @brief Представление коэффициентов числа (действительно, пока число не изменяется)
+    /// @param[in] number Число
+    BasicBigNumberView(const BigNumber &number) : BasicBigNumberView(number.coefficients_.data(), number.length_)
+    {
+    }
+
+    /// @brief Представление записи BasicBigNumber::Serialize без копирования
+    ///
+    /// Слова записи используются как массив коэффициентов напрямую, поэтому
+    /// нужна little-endian платформа и выравнивание слов по BaseType (буфер от
+    /// new или mmap, запись со смещением, кратным 8).
+    /// @param[in] data Начало записи
+    /// @param[in] size Доступно байт
+    /// @param[out] consumed Размер записи в байтах (если не nullptr)
+    /// @throw std::invalid_argument если запись обрезана или слова не выровнены
+    /// @throw std::runtime_error на big-endian платформе
+    static BasicBigNumberView FromSerialized(const unsigned char *data, std::size_t size,
+                                             std::size_t *consumed = nullptr)
+    {
+        if (__BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__)
+            throw std::runtime_error("Zero-copy views require a little-endian platform.");
+        const std::size_t words = BigNumber::SerializedWords(data, size);
+        const unsigned char *limbs = data + sizeof(std::uint64_t);
+        if (reinterpret_cast<std::uintptr_t>(limbs) % alignof(BaseType) != 0)
+            throw std::invalid_argument("The serialized limbs are not aligned.");
+        if (consumed != nullptr)
+            *consumed = sizeof(std::uint64_t) * (words + 1);
+        return BasicBigNumberView(reinterpret_cast<const BaseType *>(limbs),
+                                  static_cast<int>(words * (64 / BASE_SIZE)));
+    }
+
+    /// @brief Указатель на коэффициенты
+    const BaseType *Data() const
+    {
+        return limbs_;
+    }
+
+    /// @brief Количество значащих коэффициентов (0 для нуля)
+    int GetLength() const
+    {
+        return length_;
+    }
+
+    /// @brief Проверка на ноль
+    bool IsZero() const
+    {
+        return length_ == 0;
+    }
+
+    /// @brief Проверка на единицу
+    bool IsOne() const
+    {
+        return length_ == 1 && limbs_[0] == 1;
+    }
+
+    /// @brief Проверка на нечетность
+    bool IsOdd() const
+    {
+        return length_ > 0 && (limbs_[0] & 1) != 0;
+    }
+
+    /// @brief Проверяет бит с заданным номером (биты за пределами числа равны 0)
+    /// @param[in] index Неотрицательный номер бита (0 — младший)
+    bool TestBit(int index) const
+    {
+        const int limb = index / BASE_SIZE;
+        return limb < length_ && ((limbs_[limb] >> (index % BASE_SIZE)) & 1) != 0;
+    }
+
+    /// @brief Длина числа в битах; 0 для нуля
+    int BitLength() const
+    {
+        if (length_ == 0)
+            return 0;
+        int bits = (length_ - 1) * BASE_SIZE;
+        for (BaseType top = limbs_[length_ - 1]; top != 0; top >>= 1)
+            ++bits;
+        return bits;
+    }
+
+    /// @brief Копия числа во владеющем BasicBigNumber
+    BigNumber ToNumber() const
+    {
+        BigNumber number(std::max(length_, 1));
+        std::copy(limbs_, limbs_ + length_, number.coefficients_.data());
+        number.length_ = std::max(length_, 1);
+        return number;
+    }
+
+    /// @brief Трехзначное сравнение
+    /// @return -1, 0 или 1, если a меньше, равно или больше b
+    static int Compare(const BasicBigNumberView &a, const BasicBigNumberView &b)
+    {
+        if (a.length_ != b.length_)
+            return a.length_ < b.length_ ? -1 : 1;
+        for (int i = a.length_ - 1; i >= 0; --i)
+        {
+            if (a.limbs_[i] != b.limbs_[i])
+                return a.limbs_[i] < b.limbs_[i] ? -1 : 1;
+        }
+        return 0;
+    }
+
+    // Сравнения находятся поиском, зависящим от аргументов, и принимают BigNumber с любой стороны
+    friend bool operator==(const BasicBigNumberView &a, const BasicBigNumberView &b)
+    {
+        return Compare(a, b) == 0;
+    }
+
+    friend bool operator!=(const BasicBigNumberView &a, const BasicBigNumberView &b)
+    {
+        return Compare(a, b) != 0;
+    }
+
+    friend bool operator<(const BasicBigNumberView &a, const BasicBigNumberView &b)
+    {
+        return Compare(a, b) < 0;
+    }
+
+    friend bool operator>(const BasicBigNumberView &a, const BasicBigNumberView &b)
+    {
+        return Compare(a, b) > 0;
+    }
+
+    friend bool operator<=(const BasicBigNumberView &a, const BasicBigNumberView &b)
+    {
+        return Compare(a, b) <= 0;
+    }
+
+    friend bool operator>=(const BasicBigNumberView &a, const BasicBigNumberView &b)
+    {
+        return Compare(a, b) >= 0;
+    }
+
+  private:
+    const BaseType *limbs_; ///< Внешние коэффициенты (младший разряд имеет индекс 0)
+    int length_;            ///< Количество значащих коэффициентов
+};
+
+using BigNumberView = BasicBigNumberView<std::uint64_t>;   ///< Представление BigNumber
+using BigNumberView32 = BasicBigNumberView<std::uint32_t>; ///< Представление BigNumber32
+
+} // namespace big_number
+
+#endif // BIG_NUMBER_VIEW_HPP
@@ -0,0 +1,257 @@
+#ifndef DIVISOR_HPP
+#define DIVISOR_HPP
+
+#include "big_number.hpp"
+
+#include <vector>
+
+namespace big_number
+{
+/// @brief Деление на инвариантный коэффициент через предвычисленную обратную величину
+///
+/// Möller, Granlund, "Improved division by invariant integers" (2011), алгоритм 4.
+/// При построении делитель нормализуется сдвигом (старший бит равен 1) и один раз
+/// вычисляется v = floor((b^2 - 1) / d) - b, где b = 2^BASE_SIZE. После этого каждый
+/// шаг деления двух коэффициентов на один выполняется одним умножением и парой
+/// корректировок вместо аппаратного деления.
+/// @tparam Limb Тип коэффициента: std::uint32_t или std::uint64_t
+template <typename Limb> class BasicLimbDivisor
+{
+  public:
+    using BigNumber = BasicBigNumber<Limb>;
+    using BaseType = typename BigNumber::BaseType;
+    using DoubleBaseType = typename BigNumber::DoubleBaseType;
+
+    static constexpr int BASE_SIZE = BigNumber::BASE_SIZE; ///< Размер коэффициента в битах
+
+    /// @brief Строит делитель
+    /// @param[in] divisor Ненулевой делитель
+    /// @throw std::invalid_argument если делитель равен нулю
+    explicit BasicLimbDivisor(BaseType divisor) : divisor_(divisor), shift_(0)
+    {
+        if (divisor == 0)
+            throw std::invalid_argument("Division by zero.");
+        while ((static_cast<BaseType>(divisor << shift_) >> (BASE_SIZE - 1)) == 0)
+            ++shift_;
+        normalized_ = static_cast<BaseType>(divisor << shift_);
+        reciprocal_ = Reciprocal(normalized_);
+    }
+
+    /// @brief Делитель
+    BaseType Divisor() const
+    {
+        return divisor_;
+    }
+
+    /// @brief Обратная величина v = floor((b^2 - 1) / d) - b для нормализованного d
+    static BaseType Reciprocal(BaseType normalized)
+    {
+        // (b^2 - 1) - b * d = (b - 1 - d) * b + (b - 1)
+        const DoubleBaseType numerator =
+            (static_cast<DoubleBaseType>(static_cast<BaseType>(~normalized)) << BASE_SIZE) | static_cast<BaseType>(~0);
+        return static_cast<BaseType>(numerator / normalized);
+    }
+
+    /// @brief Деление (u1, u0) на нормализованный делитель, u1 < d
+    /// @param[in] u1 Старший коэффициент делимого
+    /// @param[in] u0 Младший коэффициент делимого
+    /// @param[out] remainder Остаток
+    /// @return Частное
+    BaseType DivideStep(BaseType u1, BaseType u0, BaseType &remainder) const
+    {
+        DoubleBaseType q = static_cast<DoubleBaseType>(reciprocal_) * u1;
+        q += (static_cast<DoubleBaseType>(u1) << BASE_SIZE) | u0;
+        BaseType q1 = static_cast<BaseType>(q >> BASE_SIZE) + 1;
+        const BaseType q0 = static_cast<BaseType>(q);
+        BaseType r = static_cast<BaseType>(u0 - q1 * normalized_);
+        if (r > q0)
+        {
+            --q1;
+            r += normalized_;
+        }
+        if (r >= normalized_)
+        {
+            ++q1;
+            r -= normalized_;
+        }
+        remainder = r;
+        return q1;
+    }
+
+    /// @brief Делит массив коэффициентов на делитель
+    /// @param[out] quotient Частное (length коэффициентов); может совпадать с u
+    /// @param[in] u Делимое (младший коэффициент первым)
+    /// @param[in] length Длина делимого
+    /// @return Остаток
+    BaseType Divide(BaseType *quotient, const BaseType *u, int length) const
+    {
+        // Делимое сдвигается на лету на тот же сдвиг, что и делитель
+        BaseType r = shift_ ? static_cast<BaseType>(u[length - 1] >> (BASE_SIZE - shift_)) : 0;
+        for (int i = length - 1; i >= 0; --i)
+        {
+            BaseType word = static_cast<BaseType>(u[i] << shift_);
+            if (shift_ && i > 0)
+                word |= static_cast<BaseType>(u[i - 1] >> (BASE_SIZE - shift_));
+            quotient[i] = DivideStep(r, word, r);
+        }
+        return static_cast<BaseType>(r >> shift_);
+    }
+
+    /// @brief Остаток от деления массива коэффициентов на делитель
+    /// @param[in] u Делимое (младший коэффициент первым)
+    /// @param[in] length Длина делимого
+    /// @return Остаток
+    BaseType Remainder(const BaseType *u, int length) const
+    {
+        BaseType r = shift_ ? static_cast<BaseType>(u[length - 1] >> (BASE_SIZE - shift_)) : 0;
+        for (int i = length - 1; i >= 0; --i)
+        {
+            BaseType word = static_cast<BaseType>(u[i] << shift_);
+            if (shift_ && i > 0)
+                word |= static_cast<BaseType>(u[i - 1] >> (BASE_SIZE - shift_));
+            DivideStep(r, word, r);
+        }
+        return static_cast<BaseType>(r >> shift_);
+    }
+
+    /// @brief Частное от деления большого числа на делитель
+    /// @param[in] u Делимое
+    /// @param[out] remainder Остаток
+    /// @return Частное
+    BigNumber Divide(const BigNumber &u, BaseType &remainder) const
+    {
+        BigNumber quotient(u.length_);
+        remainder = Divide(quotient.coefficients_.data(), u.coefficients_.data(), u.length_);
+        quotient.length_ = u.length_;
+        quotient.NormalizeLength();
+        return quotient;
+    }
+
+    /// @brief Остаток от деления большого числа на делитель
+    BaseType Remainder(const BigNumber &u) const
+    {
+        return Remainder(u.coefficients_.data(), u.length_);
+    }
+
+  private:
+    BaseType divisor_;    ///< Исходный делитель
+    BaseType normalized_; ///< Делитель, сдвинутый до единичного старшего бита
+    BaseType reciprocal_; ///< floor((b^2 - 1) / normalized_) - b
+    int shift_;           ///< Сдвиг нормализации
+};
+
+/// @brief Деление трех коэффициентов на два через предвычисленную обратную величину
+///
+/// Möller, Granlund, алгоритмы 5 и 6: оценка очередной цифры частного в делении
+/// Кнута по трем старшим коэффициентам остатка и двум старшим коэффициентам
+/// нормализованного делителя. Результат точен для этих коэффициентов, поэтому
+/// цифра частного либо верна, либо больше верной на единицу.
+/// @tparam Limb Тип коэффициента: std::uint32_t или std::uint64_t
+template <typename Limb> class BasicTwoLimbDivisor
+{
+  public:
+    using BaseType = Limb;
+    using DoubleBaseType = typename LimbTraits<Limb>::DoubleType;
+
+    static constexpr int BASE_SIZE = sizeof(BaseType) * 8; ///< Размер коэффициента в битах
+
+    BasicTwoLimbDivisor() : d1_(0), d0_(0), reciprocal_(0)
+    {
+    }
+
+    /// @brief Строит делитель (d1, d0)
+    /// @param[in] d1 Старший коэффициент со старшим битом, равным 1
+    /// @param[in] d0 Младший коэффициент
+    BasicTwoLimbDivisor(BaseType d1, BaseType d0) : d1_(d1), d0_(d0)
+    {
+        BaseType v = BasicLimbDivisor<Limb>::Reciprocal(d1);
+        BaseType p = static_cast<BaseType>(d1 * v);
+        p += d0;
+        if (p < d0)
+        {
+            --v;
+            if (p >= d1)
+            {
+                --v;
+                p -= d1;
+            }
+            p -= d1;
+        }
+        const DoubleBaseType t = static_cast<DoubleBaseType>(v) * d0;
+        const BaseType t1 = static_cast<BaseType>(t >> BASE_SIZE);
+        const BaseType t0 = static_cast<BaseType>(t);
+        p += t1;
+        if (p < t1)
+        {
+            --v;
+            if (p > d1 || (p == d1 && t0 >= d0))
+                --v;
+        }
+        reciprocal_ = v;
+    }
+
+    /// @brief Деление (u2, u1, u0) на (d1, d0), где (u2, u1) < (d1, d0)
+    /// @param[out] r1 Старший коэффициент остатка
+    /// @param[out] r0 Младший коэффициент остатка
+    /// @return Частное
+    BaseType DivideStep(BaseType u2, BaseType u1, BaseType u0, BaseType &r1, BaseType &r0) const
+    {
+        const DoubleBaseType d = (static_cast<DoubleBaseType>(d1_) << BASE_SIZE) | d0_;
+        DoubleBaseType q = static_cast<DoubleBaseType>(reciprocal_) * u2;
+        q += (static_cast<DoubleBaseType>(u2) << BASE_SIZE) | u1;
+        BaseType q1 = static_cast<BaseType>(q >> BASE_SIZE);
+        const BaseType q0 = static_cast<BaseType>(q);
+
+        const BaseType high = static_cast<BaseType>(u1 - q1 * d1_);
+        DoubleBaseType r = (static_cast<DoubleBaseType>(high) << BASE_SIZE) | u0;
+        r -= static_cast<DoubleBaseType>(d0_) * q1;
+        r -= d;
+        ++q1;
+        if (static_cast<BaseType>(r >> BASE_SIZE) >= q0)
+        {
+            --q1;
+            r += d;
+        }
+        if (r >= d)
+        {
+            ++q1;
+            r -= d;
+        }
+        r1 = static_cast<BaseType>(r >> BASE_SIZE);
+        r0 = static_cast<BaseType>(r);
+        return q1;
+    }
+
+  private:
+    BaseType d1_;         ///< Старший коэффициент делителя
+    BaseType d0_;         ///< Младший коэффициент делителя
+    BaseType reciprocal_; ///< floor((b^3 - 1) / (d1, d0)) - b
+};
+
+/// @brief Рабочая память деления BasicBigNumber::DivMod
+///
+/// Хранит нормализованный делитель последнего деления (сдвинутый так, что старший
+/// бит равен единице) вместе с обратной величиной двух его старших коэффициентов
+/// и буфер делимого. Буферы только растут, поэтому после первого деления память
+/// не выделяется, пока длины операндов не увеличатся.
+/// @tparam Limb Тип коэффициента: std::uint32_t или std::uint64_t
+template <typename Limb> class BasicDivisionWorkspace
+{
+    friend class BasicBigNumber<Limb>;
+
+    std::vector<Limb> divisor_;            ///< Делитель последнего деления (ключ кэша)
+    std::vector<Limb> normalized_;         ///< Нормализованный делитель
+    std::vector<Limb> dividend_;           ///< Нормализованное делимое; после деления — нормализованный остаток
+    BasicTwoLimbDivisor<Limb> topDivisor_; ///< Два старших коэффициента нормализованного делителя
+    int shift_ = 0;                        ///< Сдвиг нормализации в битах
+};
+
+using LimbDivisor = BasicLimbDivisor<std::uint64_t>;   ///< Делитель-коэффициент для BigNumber
+using LimbDivisor32 = BasicLimbDivisor<std::uint32_t>; ///< Делитель-коэффициент для BigNumber32
+
+using DivisionWorkspace = BasicDivisionWorkspace<std::uint64_t>;   ///< Рабочая память деления для BigNumber
+using DivisionWorkspace32 = BasicDivisionWorkspace<std::uint32_t>; ///< Рабочая память деления для BigNumber32
+
+} // namespace big_number
+
+#endif // DIVISOR_HPP
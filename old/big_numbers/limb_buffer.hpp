@@ -0,0 +1,214 @@
+#ifndef LIMB_BUFFER_HPP
+#define LIMB_BUFFER_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+#include "arena.hpp"
+
+/// Количество коэффициентов, которые хранятся внутри объекта без обращения к куче
+#ifndef BIG_NUMBER_INLINE_LIMBS
+#define BIG_NUMBER_INLINE_LIMBS 8
+#endif
+
+namespace big_number
+{
+/// @brief Буфер коэффициентов с оптимизацией малого размера
+///
+/// Первые InlineCapacity коэффициентов хранятся внутри объекта; куча
+/// используется только когда число не помещается. Внешняя память берется
+/// через AllocateLimbs, то есть из арены потока внутри ArenaScope. Интерфейс
+/// повторяет используемое подмножество std::vector.
+/// @tparam T Тип коэффициента (тривиально копируемый)
+/// @tparam InlineCapacity Вместимость встроенного хранилища
+template <typename T, std::size_t InlineCapacity> class SmallLimbBuffer
+{
+    static_assert(std::is_trivially_copyable<T>::value, "Коэффициенты должны быть тривиально копируемыми");
+    static_assert(InlineCapacity > 0, "Встроенное хранилище не может быть пустым");
+
+  public:
+    SmallLimbBuffer() : data_(inline_), size_(0), capacity_(InlineCapacity)
+    {
+    }
+
+    SmallLimbBuffer(const SmallLimbBuffer &other) : SmallLimbBuffer()
+    {
+        CopyFrom(other);
+    }
+
+    SmallLimbBuffer(SmallLimbBuffer &&other) noexcept : SmallLimbBuffer()
+    {
+        StealFrom(other);
+    }
+
+    ~SmallLimbBuffer()
+    {
+        Release();
+    }
+
+    SmallLimbBuffer &operator=(const SmallLimbBuffer &other)
+    {
+        if (this != &other)
+        {
+            CopyFrom(other);
+        }
+        return *this;
+    }
+
+    SmallLimbBuffer &operator=(SmallLimbBuffer &&other) noexcept
+    {
+        if (this != &other)
+        {
+            Release();
+            data_ = inline_;
+            capacity_ = InlineCapacity;
+            StealFrom(other);
+        }
+        return *this;
+    }
+
+    std::size_t size() const
+    {
+        return size_;
+    }
+
+    std::size_t capacity() const
+    {
+        return capacity_;
+    }
+
+    bool empty() const
+    {
+        return size_ == 0;
+    }
+
+    /// @brief Проверяет, вынесены ли коэффициенты в кучу
+    bool OnHeap() const
+    {
+        return data_ != inline_;
+    }
+
+    T *data()
+    {
+        return data_;
+    }
+
+    const T *data() const
+    {
+        return data_;
+    }
+
+    T &operator[](std::size_t index)
+    {
+        return data_[index];
+    }
+
+    const T &operator[](std::size_t index) const
+    {
+        return data_[index];
+    }
+
+    T &back()
+    {
+        return data_[size_ - 1];
+    }
+
+    /// @brief Гарантирует вместимость не меньше newCapacity, сохраняя содержимое
+    void reserve(std::size_t newCapacity)
+    {
+        if (newCapacity <= capacity_)
+            return;
+        newCapacity = std::max(newCapacity, capacity_ * 2);
+        T *fresh = Allocate(newCapacity);
+        std::memcpy(fresh, data_, size_ * sizeof(T));
+        Release();
+        data_ = fresh;
+        capacity_ = newCapacity;
+    }
+
+    /// @brief Изменяет размер; новые элементы заполняются значением value
+    void resize(std::size_t newSize, T value = T())
+    {
+        reserve(newSize);
+        if (newSize > size_)
+            std::fill(data_ + size_, data_ + newSize, value);
+        size_ = newSize;
+    }
+
+    /// @brief Заменяет содержимое count копиями value
+    void assign(std::size_t count, T value)
+    {
+        size_ = 0;
+        resize(count, value);
+    }
+
+    void push_back(T value)
+    {
+        reserve(size_ + 1);
+        data_[size_++] = value;
+    }
+
+    void pop_back()
+    {
+        --size_;
+    }
+
+    void clear()
+    {
+        size_ = 0;
+    }
+
+  private:
+    static T *Allocate(std::size_t count)
+    {
+        return static_cast<T *>(AllocateLimbs(count * sizeof(T)));
+    }
+
+    static void Deallocate(T *pointer, std::size_t count)
+    {
+        DeallocateLimbs(pointer, count * sizeof(T));
+    }
+
+    void Release()
+    {
+        if (OnHeap())
+            Deallocate(data_, capacity_);
+    }
+
+    void CopyFrom(const SmallLimbBuffer &other)
+    {
+        size_ = 0;
+        reserve(other.size_);
+        std::memcpy(data_, other.data_, other.size_ * sizeof(T));
+        size_ = other.size_;
+    }
+
+    // Ожидает, что собственный буфер встроенный и пустой
+    void StealFrom(SmallLimbBuffer &other)
+    {
+        if (other.OnHeap())
+        {
+            data_ = other.data_;
+            capacity_ = other.capacity_;
+            other.data_ = other.inline_;
+            other.capacity_ = InlineCapacity;
+        }
+        else
+        {
+            std::memcpy(inline_, other.inline_, other.size_ * sizeof(T));
+        }
+        size_ = other.size_;
+        other.size_ = 0;
+    }
+
+    T *data_;
+    std::size_t size_;
+    std::size_t capacity_;
+    T inline_[InlineCapacity];
+};
+
+} // namespace big_number
+
+#endif // LIMB_BUFFER_HPP
@@ -0,0 +1,443 @@
+#include "limb_kernels.hpp"
+#include "big_number.hpp"
+
+#if defined(__x86_64__) && defined(__GNUC__) && !defined(BIG_NUMBER_PORTABLE_KERNELS)
+#define BIG_NUMBER_X86_64_KERNELS 1
+#include <cpuid.h>
+#endif
+
+namespace big_number
+{
+namespace kernels
+{
+namespace
+{
+// Переносимые реализации
+
+template <typename Limb> Limb AddNPortable(Limb *r, const Limb *a, const Limb *b, int n)
+{
+    Limb carry = 0;
+    for (int i = 0; i < n; ++i)
+    {
+        Limb sum = a[i] + carry;
+        carry = sum < carry;
+        sum += b[i];
+        carry += sum < b[i];
+        r[i] = sum;
+    }
+    return carry;
+}
+
+template <typename Limb> Limb SubNPortable(Limb *r, const Limb *a, const Limb *b, int n)
+{
+    Limb borrow = 0;
+    for (int i = 0; i < n; ++i)
+    {
+        Limb diff = a[i] - borrow;
+        borrow = diff > a[i];
+        borrow += diff < b[i];
+        r[i] = diff - b[i];
+    }
+    return borrow;
+}
+
+template <typename Limb> Limb Mul1Portable(Limb *r, const Limb *a, int n, Limb b)
+{
+    using DoubleLimb = typename LimbTraits<Limb>::DoubleType;
+    constexpr int bits = sizeof(Limb) * 8;
+    Limb carry = 0;
+    for (int i = 0; i < n; ++i)
+    {
+        DoubleLimb product = static_cast<DoubleLimb>(a[i]) * b + carry;
+        r[i] = static_cast<Limb>(product);
+        carry = static_cast<Limb>(product >> bits);
+    }
+    return carry;
+}
+
+template <typename Limb> Limb AddMul1Portable(Limb *r, const Limb *a, int n, Limb b)
+{
+    using DoubleLimb = typename LimbTraits<Limb>::DoubleType;
+    constexpr int bits = sizeof(Limb) * 8;
+    Limb carry = 0;
+    for (int i = 0; i < n; ++i)
+    {
+        DoubleLimb product = static_cast<DoubleLimb>(a[i]) * b + r[i] + carry;
+        r[i] = static_cast<Limb>(product);
+        carry = static_cast<Limb>(product >> bits);
+    }
+    return carry;
+}
+
+template <typename Limb> Limb SubMul1Portable(Limb *r, const Limb *a, int n, Limb b)
+{
+    using DoubleLimb = typename LimbTraits<Limb>::DoubleType;
+    constexpr int bits = sizeof(Limb) * 8;
+    Limb carry = 0;
+    for (int i = 0; i < n; ++i)
+    {
+        DoubleLimb product = static_cast<DoubleLimb>(a[i]) * b + carry;
+        Limb low = static_cast<Limb>(product);
+        carry = static_cast<Limb>(product >> bits) + (r[i] < low);
+        r[i] -= low;
+    }
+    return carry;
+}
+
+#ifdef BIG_NUMBER_X86_64_KERNELS
+// Реализации для x86-64. Циклы развернуты на четыре коэффициента, остаток
+// n mod 4 обрабатывается первым. Счетчики уменьшаются командами, не портящими
+// нужные флаги: dec сохраняет CF, а в цепочках adcx/adox (CF и OF) счетчик
+// уменьшается через lea и проверяется jrcxz.
+
+std::uint64_t AddNX86(std::uint64_t *r, const std::uint64_t *a, const std::uint64_t *b, int n)
+{
+    std::uint64_t remainder = static_cast<std::uint64_t>(n) & 3;
+    std::uint64_t blocks = static_cast<std::uint64_t>(n) >> 2;
+    std::uint64_t carry;
+    std::uint64_t t0;
+    std::uint64_t t1;
+    __asm__ volatile("xor %k[carry], %k[carry]\n\t"
+                     "test %[rem], %[rem]\n\t"
+                     "jz 2f\n"
+                     "1:\n\t"
+                     "mov (%[a]), %[t0]\n\t"
+                     "adc (%[b]), %[t0]\n\t"
+                     "mov %[t0], (%[r])\n\t"
+                     "lea 8(%[a]), %[a]\n\t"
+                     "lea 8(%[b]), %[b]\n\t"
+                     "lea 8(%[r]), %[r]\n\t"
+                     "dec %[rem]\n\t"
+                     "jnz 1b\n"
+                     "2:\n\t"
+                     "jrcxz 4f\n"
+                     "3:\n\t"
+                     "mov (%[a]), %[t0]\n\t"
+                     "mov 8(%[a]), %[t1]\n\t"
+                     "adc (%[b]), %[t0]\n\t"
+                     "adc 8(%[b]), %[t1]\n\t"
+                     "mov %[t0], (%[r])\n\t"
+                     "mov %[t1], 8(%[r])\n\t"
+                     "mov 16(%[a]), %[t0]\n\t"
+                     "mov 24(%[a]), %[t1]\n\t"
+                     "adc 16(%[b]), %[t0]\n\t"
+                     "adc 24(%[b]), %[t1]\n\t"
+                     "mov %[t0], 16(%[r])\n\t"
+                     "mov %[t1], 24(%[r])\n\t"
+                     "lea 32(%[a]), %[a]\n\t"
+                     "lea 32(%[b]), %[b]\n\t"
+                     "lea 32(%[r]), %[r]\n\t"
+                     "dec %[blocks]\n\t"
+                     "jnz 3b\n"
+                     "4:\n\t"
+                     "adc $0, %[carry]"
+                     : [carry] "=&r"(carry), [t0] "=&r"(t0), [t1] "=&r"(t1), [r] "+r"(r), [a] "+r"(a), [b] "+r"(b),
+                       [rem] "+r"(remainder), [blocks] "+c"(blocks)
+                     :
+                     : "cc", "memory");
+    return carry;
+}
+
+std::uint64_t SubNX86(std::uint64_t *r, const std::uint64_t *a, const std::uint64_t *b, int n)
+{
+    std::uint64_t remainder = static_cast<std::uint64_t>(n) & 3;
+    std::uint64_t blocks = static_cast<std::uint64_t>(n) >> 2;
+    std::uint64_t borrow;
+    std::uint64_t t0;
+    std::uint64_t t1;
+    __asm__ volatile("xor %k[borrow], %k[borrow]\n\t"
+                     "test %[rem], %[rem]\n\t"
+                     "jz 2f\n"
+                     "1:\n\t"
+                     "mov (%[a]), %[t0]\n\t"
+                     "sbb (%[b]), %[t0]\n\t"
+                     "mov %[t0], (%[r])\n\t"
+                     "lea 8(%[a]), %[a]\n\t"
+                     "lea 8(%[b]), %[b]\n\t"
+                     "lea 8(%[r]), %[r]\n\t"
+                     "dec %[rem]\n\t"
+                     "jnz 1b\n"
+                     "2:\n\t"
+                     "jrcxz 4f\n"
+                     "3:\n\t"
+                     "mov (%[a]), %[t0]\n\t"
+                     "mov 8(%[a]), %[t1]\n\t"
+                     "sbb (%[b]), %[t0]\n\t"
+                     "sbb 8(%[b]), %[t1]\n\t"
+                     "mov %[t0], (%[r])\n\t"
+                     "mov %[t1], 8(%[r])\n\t"
+                     "mov 16(%[a]), %[t0]\n\t"
+                     "mov 24(%[a]), %[t1]\n\t"
+                     "sbb 16(%[b]), %[t0]\n\t"
+                     "sbb 24(%[b]), %[t1]\n\t"
+                     "mov %[t0], 16(%[r])\n\t"
+                     "mov %[t1], 24(%[r])\n\t"
+                     "lea 32(%[a]), %[a]\n\t"
+                     "lea 32(%[b]), %[b]\n\t"
+                     "lea 32(%[r]), %[r]\n\t"
+                     "dec %[blocks]\n\t"
+                     "jnz 3b\n"
+                     "4:\n\t"
+                     "adc $0, %[borrow]"
+                     : [borrow] "=&r"(borrow), [t0] "=&r"(t0), [t1] "=&r"(t1), [r] "+r"(r), [a] "+r"(a), [b] "+r"(b),
+                       [rem] "+r"(remainder), [blocks] "+c"(blocks)
+                     :
+                     : "cc", "memory");
+    return borrow;
+}
+
+// Умножение на коэффициент через mulx: mulx не меняет флаги, поэтому перенос
+// между младшими и старшими половинами произведений идет одной цепочкой adc
+std::uint64_t Mul1X86(std::uint64_t *r, const std::uint64_t *a, int n, std::uint64_t b)
+{
+    const int head = n & 3;
+    std::uint64_t carry = Mul1Portable(r, a, head, b);
+    std::uint64_t blocks = static_cast<std::uint64_t>(n) >> 2;
+    if (blocks == 0)
+        return carry;
+    r += head;
+    a += head;
+    std::uint64_t low0;
+    std::uint64_t high0;
+    std::uint64_t low1;
+    __asm__ volatile("xor %k[low0], %k[low0]\n"
+                     "1:\n\t"
+                     "mulx (%[a]), %[low0], %[high0]\n\t"
+                     "adc %[carry], %[low0]\n\t"
+                     "mov %[low0], (%[r])\n\t"
+                     "mulx 8(%[a]), %[low1], %[carry]\n\t"
+                     "adc %[high0], %[low1]\n\t"
+                     "mov %[low1], 8(%[r])\n\t"
+                     "mulx 16(%[a]), %[low0], %[high0]\n\t"
+                     "adc %[carry], %[low0]\n\t"
+                     "mov %[low0], 16(%[r])\n\t"
+                     "mulx 24(%[a]), %[low1], %[carry]\n\t"
+                     "adc %[high0], %[low1]\n\t"
+                     "mov %[low1], 24(%[r])\n\t"
+                     "lea 32(%[a]), %[a]\n\t"
+                     "lea 32(%[r]), %[r]\n\t"
+                     "dec %[blocks]\n\t"
+                     "jnz 1b\n\t"
+                     "adc $0, %[carry]"
+                     : [carry] "+&r"(carry), [low0] "=&r"(low0), [high0] "=&r"(high0), [low1] "=&r"(low1),
+                       [r] "+r"(r), [a] "+r"(a), [blocks] "+r"(blocks)
+                     : "d"(b)
+                     : "cc", "memory");
+    return carry;
+}
+
+// r += a * b: цепочка CF (adcx) складывает младшую половину произведения со старшей
+// половиной предыдущего, цепочка OF (adox) прибавляет результат к r[i]
+std::uint64_t AddMul1X86(std::uint64_t *r, const std::uint64_t *a, int n, std::uint64_t b)
+{
+    const int head = n & 3;
+    std::uint64_t carry = AddMul1Portable(r, a, head, b);
+    std::uint64_t blocks = static_cast<std::uint64_t>(n) >> 2;
+    if (blocks == 0)
+        return carry;
+    r += head;
+    a += head;
+    std::uint64_t zero;
+    std::uint64_t low0;
+    std::uint64_t high0;
+    std::uint64_t low1;
+    __asm__ volatile("xor %k[zero], %k[zero]\n"
+                     "1:\n\t"
+                     "mulx (%[a]), %[low0], %[high0]\n\t"
+                     "adcx %[carry], %[low0]\n\t"
+                     "adox (%[r]), %[low0]\n\t"
+                     "mov %[low0], (%[r])\n\t"
+                     "mulx 8(%[a]), %[low1], %[carry]\n\t"
+                     "adcx %[high0], %[low1]\n\t"
+                     "adox 8(%[r]), %[low1]\n\t"
+                     "mov %[low1], 8(%[r])\n\t"
+                     "mulx 16(%[a]), %[low0], %[high0]\n\t"
+                     "adcx %[carry], %[low0]\n\t"
+                     "adox 16(%[r]), %[low0]\n\t"
+                     "mov %[low0], 16(%[r])\n\t"
+                     "mulx 24(%[a]), %[low1], %[carry]\n\t"
+                     "adcx %[high0], %[low1]\n\t"
+                     "adox 24(%[r]), %[low1]\n\t"
+                     "mov %[low1], 24(%[r])\n\t"
+                     "lea 32(%[a]), %[a]\n\t"
+                     "lea 32(%[r]), %[r]\n\t"
+                     "lea -1(%[blocks]), %[blocks]\n\t"
+                     "jrcxz 2f\n\t"
+                     "jmp 1b\n"
+                     "2:\n\t"
+                     "adcx %[zero], %[carry]\n\t"
+                     "adox %[zero], %[carry]"
+                     : [carry] "+&r"(carry), [zero] "=&r"(zero), [low0] "=&r"(low0), [high0] "=&r"(high0),
+                       [low1] "=&r"(low1), [r] "+r"(r), [a] "+r"(a), [blocks] "+c"(blocks)
+                     : "d"(b)
+                     : "cc", "memory");
+    return carry;
+}
+
+// r -= a * b: r - t = r + ~t + 1, поэтому цепочка OF хранит отсутствие заема
+// (начинается с единицы), а к r[i] прибавляется инвертированная сумма цепочки CF
+std::uint64_t SubMul1X86(std::uint64_t *r, const std::uint64_t *a, int n, std::uint64_t b)
+{
+    const int head = n & 3;
+    std::uint64_t carry = SubMul1Portable(r, a, head, b);
+    std::uint64_t blocks = static_cast<std::uint64_t>(n) >> 2;
+    if (blocks == 0)
+        return carry;
+    r += head;
+    a += head;
+    std::uint64_t flag;
+    std::uint64_t low0;
+    std::uint64_t high0;
+    std::uint64_t low1;
+    __asm__ volatile("xor %k[flag], %k[flag]\n\t"
+                     "mov $-1, %[low0]\n\t"
+                     "adox %[low0], %[low0]\n"
+                     "1:\n\t"
+                     "mulx (%[a]), %[low0], %[high0]\n\t"
+                     "adcx %[carry], %[low0]\n\t"
+                     "not %[low0]\n\t"
+                     "adox (%[r]), %[low0]\n\t"
+                     "mov %[low0], (%[r])\n\t"
+                     "mulx 8(%[a]), %[low1], %[carry]\n\t"
+                     "adcx %[high0], %[low1]\n\t"
+                     "not %[low1]\n\t"
+                     "adox 8(%[r]), %[low1]\n\t"
+                     "mov %[low1], 8(%[r])\n\t"
+                     "mulx 16(%[a]), %[low0], %[high0]\n\t"
+                     "adcx %[carry], %[low0]\n\t"
+                     "not %[low0]\n\t"
+                     "adox 16(%[r]), %[low0]\n\t"
+                     "mov %[low0], 16(%[r])\n\t"
+                     "mulx 24(%[a]), %[low1], %[carry]\n\t"
+                     "adcx %[high0], %[low1]\n\t"
+                     "not %[low1]\n\t"
+                     "adox 24(%[r]), %[low1]\n\t"
+                     "mov %[low1], 24(%[r])\n\t"
+                     "lea 32(%[a]), %[a]\n\t"
+                     "lea 32(%[r]), %[r]\n\t"
+                     "lea -1(%[blocks]), %[blocks]\n\t"
+                     "jrcxz 2f\n\t"
+                     "jmp 1b\n"
+                     "2:\n\t"
+                     "adcx %[flag], %[carry]\n\t"
+                     "setno %b[flag]\n\t"
+                     "add %[flag], %[carry]"
+                     : [carry] "+&r"(carry), [flag] "=&q"(flag), [low0] "=&r"(low0), [high0] "=&r"(high0),
+                       [low1] "=&r"(low1), [r] "+r"(r), [a] "+r"(a), [blocks] "+c"(blocks)
+                     : "d"(b)
+                     : "cc", "memory");
+    return carry;
+}
+#endif
+
+// Реализации для 64-битных коэффициентов, выбранные один раз при первом обращении
+struct Kernels64
+{
+    std::uint64_t (*addN)(std::uint64_t *, const std::uint64_t *, const std::uint64_t *, int);
+    std::uint64_t (*subN)(std::uint64_t *, const std::uint64_t *, const std::uint64_t *, int);
+    std::uint64_t (*mul1)(std::uint64_t *, const std::uint64_t *, int, std::uint64_t);
+    std::uint64_t (*addMul1)(std::uint64_t *, const std::uint64_t *, int, std::uint64_t);
+    std::uint64_t (*subMul1)(std::uint64_t *, const std::uint64_t *, int, std::uint64_t);
+    const char *name;
+};
+
+Kernels64 SelectKernels()
+{
+    Kernels64 kernels{AddNPortable<std::uint64_t>,    SubNPortable<std::uint64_t>,    Mul1Portable<std::uint64_t>,
+                      AddMul1Portable<std::uint64_t>, SubMul1Portable<std::uint64_t>, "portable"};
+#ifdef BIG_NUMBER_X86_64_KERNELS
+    kernels.addN = AddNX86;
+    kernels.subN = SubNX86;
+    kernels.name = "x86-64";
+
+    // CPUID, лист 7: EBX бит 8 — BMI2 (mulx), бит 19 — ADX (adcx/adox)
+    unsigned eax = 0;
+    unsigned ebx = 0;
+    unsigned ecx = 0;
+    unsigned edx = 0;
+    if (__get_cpuid_max(0, nullptr) >= 7 && __get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx))
+    {
+        const bool bmi2 = (ebx >> 8) & 1;
+        const bool adx = (ebx >> 19) & 1;
+        if (bmi2)
+        {
+            kernels.mul1 = Mul1X86;
+            kernels.name = "x86-64 BMI2";
+        }
+        if (bmi2 && adx)
+        {
+            kernels.addMul1 = AddMul1X86;
+            kernels.subMul1 = SubMul1X86;
+            kernels.name = "x86-64 BMI2+ADX";
+        }
+    }
+#endif
+    return kernels;
+}
+
+const Kernels64 &Active()
+{
+    static const Kernels64 kernels = SelectKernels();
+    return kernels;
+}
+} // namespace
+
+// Для 64-битных коэффициентов вызов идет через выбранную реализацию, для 32-битных — переносимую
+template <typename Limb> Limb AddN(Limb *r, const Limb *a, const Limb *b, int n)
+{
+    if constexpr (sizeof(Limb) == 8)
+        return Active().addN(r, a, b, n);
+    else
+        return AddNPortable(r, a, b, n);
+}
+
+template <typename Limb> Limb SubN(Limb *r, const Limb *a, const Limb *b, int n)
+{
+    if constexpr (sizeof(Limb) == 8)
+        return Active().subN(r, a, b, n);
+    else
+        return SubNPortable(r, a, b, n);
+}
+
+template <typename Limb> Limb Mul1(Limb *r, const Limb *a, int n, Limb b)
+{
+    if constexpr (sizeof(Limb) == 8)
+        return Active().mul1(r, a, n, b);
+    else
+        return Mul1Portable(r, a, n, b);
+}
+
+template <typename Limb> Limb AddMul1(Limb *r, const Limb *a, int n, Limb b)
+{
+    if constexpr (sizeof(Limb) == 8)
+        return Active().addMul1(r, a, n, b);
+    else
+        return AddMul1Portable(r, a, n, b);
+}
+
+template <typename Limb> Limb SubMul1(Limb *r, const Limb *a, int n, Limb b)
+{
+    if constexpr (sizeof(Limb) == 8)
+        return Active().subMul1(r, a, n, b);
+    else
+        return SubMul1Portable(r, a, n, b);
+}
+
+const char *Implementation()
+{
+    return Active().name;
+}
+
+template std::uint32_t AddN<std::uint32_t>(std::uint32_t *, const std::uint32_t *, const std::uint32_t *, int);
+template std::uint32_t SubN<std::uint32_t>(std::uint32_t *, const std::uint32_t *, const std::uint32_t *, int);
+template std::uint32_t Mul1<std::uint32_t>(std::uint32_t *, const std::uint32_t *, int, std::uint32_t);
+template std::uint32_t AddMul1<std::uint32_t>(std::uint32_t *, const std::uint32_t *, int, std::uint32_t);
+template std::uint32_t SubMul1<std::uint32_t>(std::uint32_t *, const std::uint32_t *, int, std::uint32_t);
+template std::uint64_t AddN<std::uint64_t>(std::uint64_t *, const std::uint64_t *, const std::uint64_t *, int);
+template std::uint64_t SubN<std::uint64_t>(std::uint64_t *, const std::uint64_t *, const std::uint64_t *, int);
+template std::uint64_t Mul1<std::uint64_t>(std::uint64_t *, const std::uint64_t *, int, std::uint64_t);
+template std::uint64_t AddMul1<std::uint64_t>(std::uint64_t *, const std::uint64_t *, int, std::uint64_t);
+template std::uint64_t SubMul1<std::uint64_t>(std::uint64_t *, const std::uint64_t *, int, std::uint64_t);
+
+} // namespace kernels
+} // namespace big_number
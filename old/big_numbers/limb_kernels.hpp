@@ -0,0 +1,87 @@
+#ifndef LIMB_KERNELS_HPP
+#define LIMB_KERNELS_HPP
+
+#include <cstdint>
+
+namespace big_number
+{
+/// @brief Базовые операции над массивами коэффициентов
+///
+/// Все циклы с переносом в арифметике BigNumber, умножении, делении и
+/// контекстах Монтгомери/Барретта построены на этих функциях. Для 64-битных
+/// коэффициентов на x86-64 при первом вызове по CPUID выбирается реализация на
+/// ассемблере: сложение и вычитание цепочкой adc/sbb, умножение на коэффициент —
+/// через mulx (BMI2) и две независимые цепочки переносов adcx/adox (ADX).
+/// Иначе, а также при BIG_NUMBER_PORTABLE_KERNELS, используются переносимые
+/// циклы на удвоенном типе коэффициента.
+///
+/// Массивы задаются младшим коэффициентом первым; длина n может быть нулевой.
+/// Результат r может совпадать с любым из операндов, но не пересекаться с ним
+/// со сдвигом.
+namespace kernels
+{
+/// @brief r = a + b
+/// @return Перенос из старшего коэффициента (0 или 1)
+template <typename Limb> Limb AddN(Limb *r, const Limb *a, const Limb *b, int n);
+
+/// @brief r = a - b
+/// @return Заем из старшего коэффициента (0 или 1)
+template <typename Limb> Limb SubN(Limb *r, const Limb *a, const Limb *b, int n);
+
+/// @brief r = a * b
+/// @return Старший коэффициент произведения
+template <typename Limb> Limb Mul1(Limb *r, const Limb *a, int n, Limb b);
+
+/// @brief r += a * b
+/// @return Перенос в коэффициент r[n]
+template <typename Limb> Limb AddMul1(Limb *r, const Limb *a, int n, Limb b);
+
+/// @brief r -= a * b
+/// @return Заем из коэффициента r[n]
+template <typename Limb> Limb SubMul1(Limb *r, const Limb *a, int n, Limb b);
+
+/// @brief Название выбранной реализации для 64-битных коэффициентов
+const char *Implementation();
+
+/// @brief r = a + b для aLength >= bLength; r имеет длину aLength
+/// @return Перенос из старшего коэффициента
+template <typename Limb> inline Limb Add(Limb *r, const Limb *a, int aLength, const Limb *b, int bLength)
+{
+    Limb carry = AddN(r, a, b, bLength);
+    int i = bLength;
+    for (; carry != 0 && i < aLength; ++i)
+    {
+        r[i] = a[i] + 1;
+        carry = r[i] == 0;
+    }
+    if (r != a)
+    {
+        for (; i < aLength; ++i)
+            r[i] = a[i];
+    }
+    return carry;
+}
+
+/// @brief r = a - b для aLength >= bLength; r имеет длину aLength
+/// @return Заем из старшего коэффициента
+template <typename Limb> inline Limb Sub(Limb *r, const Limb *a, int aLength, const Limb *b, int bLength)
+{
+    Limb borrow = SubN(r, a, b, bLength);
+    int i = bLength;
+    for (; borrow != 0 && i < aLength; ++i)
+    {
+        borrow = a[i] == 0;
+        r[i] = a[i] - 1;
+    }
+    if (r != a)
+    {
+        for (; i < aLength; ++i)
+            r[i] = a[i];
+    }
+    return borrow;
+}
+
+} // namespace kernels
+} // namespace big_number
+
+#endif // LIMB_KERNELS_HPP
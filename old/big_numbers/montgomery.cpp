@@ -0,0 +1,217 @@
+#include "montgomery.hpp"
+#include "limb_kernels.hpp"
+
+#include <algorithm>
+
+namespace big_number
+{
+template <typename Limb>
+BasicMontgomeryContext<Limb>::BasicMontgomeryContext(const View &modulus)
+    : modulus_(modulus.ToNumber()), n_(modulus_.length_), inverse_(0)
+{
+    if (modulus_ <= 1 || modulus_.IsEven())
+        throw std::invalid_argument("The Montgomery modulus must be odd and greater than 1.");
+
+    // Итерация Ньютона x = x * (2 - m * x) удваивает число верных младших бит m^(-1)
+    const BaseType m0 = modulus_.coefficients_[0];
+    BaseType inverse = m0; // для нечетного m0 верны 3 младших бита
+    for (int bits = 3; bits < BigNumber::BASE_SIZE; bits *= 2)
+        inverse *= static_cast<BaseType>(2 - m0 * inverse);
+    inverse_ = static_cast<BaseType>(~inverse + 1);
+
+    // R mod m и R^2 mod m вычисляются делением один раз
+    BigNumber r(n_ + 1);
+    r.coefficients_[n_] = 1;
+    r.length_ = n_ + 1;
+    one_.resize(n_);
+    Load(one_.data(), r % modulus_);
+
+    BigNumber rSquared(2 * n_ + 1);
+    rSquared.coefficients_[2 * n_] = 1;
+    rSquared.length_ = 2 * n_ + 1;
+    rSquared_.resize(n_);
+    Load(rSquared_.data(), rSquared % modulus_);
+}
+
+template <typename Limb> const BasicBigNumber<Limb> &BasicMontgomeryContext<Limb>::Modulus() const
+{
+    return modulus_;
+}
+
+template <typename Limb> int BasicMontgomeryContext<Limb>::Length() const
+{
+    return n_;
+}
+
+template <typename Limb> void BasicMontgomeryContext<Limb>::Load(BaseType *destination, const View &x) const
+{
+    const int length = std::min(x.GetLength(), n_);
+    std::copy(x.Data(), x.Data() + length, destination);
+    std::fill(destination + length, destination + n_, BaseType(0));
+}
+
+template <typename Limb> BasicBigNumber<Limb> BasicMontgomeryContext<Limb>::Store(const BaseType *source) const
+{
+    BigNumber result(n_);
+    std::copy(source, source + n_, result.coefficients_.data());
+    result.length_ = n_;
+    result.NormalizeLength();
+    return result;
+}
+
+// Koc, Acar, Kaliski, "Analyzing and Comparing Montgomery Multiplication Algorithms", метод CIOS;
+// строки a * b[i] и q * m прибавляются ядром AddMul1
+template <typename Limb>
+void BasicMontgomeryContext<Limb>::MultiplyRaw(BaseType *result, const BaseType *a, const BaseType *b,
+                                               BaseType *workspace) const
+{
+    const BaseType *m = modulus_.coefficients_.data();
+    const int n = n_;
+    BaseType *t = workspace;
+    std::fill(t, t + n + 2, BaseType(0));
+
+    for (int i = 0; i < n; ++i)
+    {
+        // t += a * b[i]
+        BaseType carry = kernels::AddMul1(t, a, n, b[i]);
+        t[n] += carry;
+        t[n + 1] = t[n] < carry;
+
+        // t = (t + q * m) / b, где q обнуляет младший коэффициент
+        const BaseType q = t[0] * inverse_;
+        carry = kernels::AddMul1(t, m, n, q);
+        t[n] += carry;
+        t[n + 1] += t[n] < carry;
+        std::copy(t + 1, t + n + 2, t);
+        t[n + 1] = 0;
+    }
+
+    // t < 2m: одно условное вычитание
+    bool subtract = t[n] != 0;
+    if (!subtract)
+    {
+        int i = n - 1;
+        while (i >= 0 && t[i] == m[i])
+            --i;
+        subtract = i < 0 || t[i] > m[i];
+    }
+    if (subtract)
+        kernels::SubN(result, t, m, n);
+    else
+        std::copy(t, t + n, result);
+}
+
+template <typename Limb> BasicBigNumber<Limb> BasicMontgomeryContext<Limb>::ToMontgomery(const BigNumber &a) const
+{
+    ScratchVector<BaseType> buffer(2 * n_ + 2);
+    Load(buffer.data(), a < modulus_ ? a : a % modulus_);
+    MultiplyRaw(buffer.data(), buffer.data(), rSquared_.data(), buffer.data() + n_);
+    return Store(buffer.data());
+}
+
+template <typename Limb>
+BasicBigNumber<Limb> BasicMontgomeryContext<Limb>::FromMontgomery(const BigNumber &a) const
+{
+    ScratchVector<BaseType> buffer(3 * n_ + 2);
+    BaseType *unit = buffer.data() + n_;
+    Load(buffer.data(), a);
+    unit[0] = 1;
+    MultiplyRaw(buffer.data(), buffer.data(), unit, buffer.data() + 2 * n_);
+    return Store(buffer.data());
+}
+
+template <typename Limb>
+BasicBigNumber<Limb> BasicMontgomeryContext<Limb>::Multiply(const BigNumber &a, const BigNumber &b) const
+{
+    ScratchVector<BaseType> buffer(3 * n_ + 2);
+    Load(buffer.data(), a);
+    Load(buffer.data() + n_, b);
+    MultiplyRaw(buffer.data(), buffer.data(), buffer.data() + n_, buffer.data() + 2 * n_);
+    return Store(buffer.data());
+}
+
+template <typename Limb> void BasicMontgomeryContext<Limb>::SquareInPlace(BigNumber &a) const
+{
+    // Рабочий буфер переиспользуется между вызовами, поэтому цикл возведений в квадрат не выделяет память
+    thread_local std::vector<BaseType> buffer;
+    buffer.resize(2 * n_ + 2);
+    Load(buffer.data(), a);
+    MultiplyRaw(buffer.data(), buffer.data(), buffer.data(), buffer.data() + n_);
+    if (a.maxLength_ < n_)
+    {
+        a.coefficients_.resize(n_, 0);
+        a.maxLength_ = n_;
+    }
+    std::copy(buffer.data(), buffer.data() + n_, a.coefficients_.data());
+    a.length_ = n_;
+    a.NormalizeLength();
+}
+
+template <typename Limb>
+BasicBigNumber<Limb> BasicMontgomeryContext<Limb>::PowMod(const View &base, const View &exponent) const
+{
+    constexpr int baseSize = BigNumber::BASE_SIZE;
+    const BaseType *e = exponent.Data();
+
+    // Биты показателя читаются прямо из коэффициентов
+    const int bitLength = exponent.BitLength();
+    if (bitLength == 0)
+        return BigNumber(1, 1);
+    auto bit = [e](int i) { return static_cast<unsigned>((e[i / baseSize] >> (i % baseSize)) & 1); };
+
+    const int window = bitLength > 768 ? 6 : (bitLength > 240 ? 5 : (bitLength > 80 ? 4 : (bitLength > 24 ? 3 : 1)));
+    const int tableSize = 1 << (window - 1);
+
+    // Вся память выделяется один раз: таблица нечетных степеней, аккумулятор, квадрат, рабочий буфер
+    const int n = n_;
+    ScratchVector<BaseType> memory(static_cast<std::size_t>(tableSize + 2) * n + n + 2);
+    BaseType *table = memory.data();
+    BaseType *accumulator = table + static_cast<std::size_t>(tableSize) * n;
+    BaseType *square = accumulator + n;
+    BaseType *workspace = square + n;
+
+    // Нечетные степени base^1, base^3, ..., base^(2^window - 1) в форме Монтгомери
+    if (base < modulus_)
+        Load(table, base);
+    else
+        Load(table, base.ToNumber() % modulus_);
+    MultiplyRaw(table, table, rSquared_.data(), workspace);
+    MultiplyRaw(square, table, table, workspace);
+    for (int i = 1; i < tableSize; ++i)
+        MultiplyRaw(table + i * n, table + (i - 1) * n, square, workspace);
+
+    std::copy(one_.begin(), one_.end(), accumulator);
+    int i = bitLength - 1;
+    while (i >= 0)
+    {
+        if (!bit(i))
+        {
+            MultiplyRaw(accumulator, accumulator, accumulator, workspace);
+            --i;
+            continue;
+        }
+        // Окно [j, i] длины не больше window, заканчивающееся единичным битом
+        int j = std::max(i - window + 1, 0);
+        while (!bit(j))
+            ++j;
+        unsigned value = 0;
+        for (int k = i; k >= j; --k)
+        {
+            MultiplyRaw(accumulator, accumulator, accumulator, workspace);
+            value = (value << 1) | bit(k);
+        }
+        MultiplyRaw(accumulator, accumulator, table + (value >> 1) * n, workspace);
+        i = j - 1;
+    }
+
+    // Выход из формы Монтгомери: умножение на 1
+    std::fill(square, square + n, BaseType(0));
+    square[0] = 1;
+    MultiplyRaw(accumulator, accumulator, square, workspace);
+    return Store(accumulator);
+}
+
+template class BasicMontgomeryContext<std::uint32_t>;
+template class BasicMontgomeryContext<std::uint64_t>;
+
+} // namespace big_number
@@ -0,0 +1,89 @@
+#ifndef BIG_NUMBER_MONTGOMERY_HPP
+#define BIG_NUMBER_MONTGOMERY_HPP
+
+#include "big_number.hpp"
+#include "big_number_view.hpp"
+
+#include <vector>
+
+namespace big_number
+{
+/// @brief Контекст арифметики Монтгомери для нечетного модуля
+///
+/// R = b^n, где b = 2^BASE_SIZE, n — длина модуля в коэффициентах. Умножение
+/// с редукцией выполняется методом CIOS (coarsely integrated operand scanning):
+/// на каждом шаге внешнего цикла к промежуточной сумме прибавляется a * b[i]
+/// и сразу же кратное модуля, обнуляющее младший коэффициент; обе строки
+/// вычисляются ядром kernels::AddMul1. Все операнды
+/// имеют фиксированную длину n, поэтому возведение в степень работает
+/// в заранее выделенной памяти. Контекст не изменяется после построения.
+/// @tparam Limb Тип коэффициента: std::uint32_t или std::uint64_t
+template <typename Limb> class BasicMontgomeryContext
+{
+  public:
+    using BigNumber = BasicBigNumber<Limb>;
+    using BaseType = typename BigNumber::BaseType;
+    using View = BasicBigNumberView<Limb>;
+
+    /// @brief Строит контекст для модуля
+    /// @param[in] modulus Нечетный модуль больше 1 (BigNumber или представление внешнего буфера)
+    /// @throw std::invalid_argument если модуль четный или не больше 1
+    explicit BasicMontgomeryContext(const View &modulus);
+
+    /// @brief Модуль контекста
+    const BigNumber &Modulus() const;
+
+    /// @brief Длина модуля (и всех операндов) в коэффициентах
+    int Length() const;
+
+    /// @brief Переводит число в форму Монтгомери: a * R mod m
+    BigNumber ToMontgomery(const BigNumber &a) const;
+
+    /// @brief Возвращает число из формы Монтгомери: a * R^(-1) mod m
+    BigNumber FromMontgomery(const BigNumber &a) const;
+
+    /// @brief Произведение в форме Монтгомери: a * b * R^(-1) mod m
+    /// @param[in] a Число в форме Монтгомери (меньше модуля)
+    /// @param[in] b Число в форме Монтгомери (меньше модуля)
+    BigNumber Multiply(const BigNumber &a, const BigNumber &b) const;
+
+    /// @brief Возведение в квадрат в форме Монтгомери на месте: a = a^2 * R^(-1) mod m
+    void SquareInPlace(BigNumber &a) const;
+
+    /// @brief Модульное возведение в степень скользящим окном
+    /// Основание меньше модуля и показатель читаются прямо из своих коэффициентов,
+    /// поэтому их можно передавать представлениями внешних буферов.
+    /// @param[in] base Основание (в обычной форме, любое неотрицательное)
+    /// @param[in] exponent Показатель
+    /// @return base^exponent mod m в обычной форме
+    BigNumber PowMod(const View &base, const View &exponent) const;
+
+    /// @brief Умножение Монтгомери (CIOS) на массивах из n коэффициентов
+    /// @param[out] result Результат a * b * R^(-1) mod m; может совпадать с a или b
+    /// @param[in] a Первый сомножитель (n коэффициентов, меньше модуля)
+    /// @param[in] b Второй сомножитель (n коэффициентов, меньше модуля)
+    /// @param[in,out] workspace Рабочий буфер из n + 2 коэффициентов, не пересекающийся с a, b и result
+    void MultiplyRaw(BaseType *result, const BaseType *a, const BaseType *b, BaseType *workspace) const;
+
+  private:
+    // Копирует x в буфер из n коэффициентов, дополняя нулями
+    void Load(BaseType *destination, const View &x) const;
+    // Собирает BigNumber из n коэффициентов
+    BigNumber Store(const BaseType *source) const;
+
+    BigNumber modulus_;
+    int n_;                          ///< Длина модуля в коэффициентах
+    BaseType inverse_;               ///< -m^(-1) mod b
+    std::vector<BaseType> rSquared_; ///< R^2 mod m
+    std::vector<BaseType> one_;      ///< R mod m — единица в форме Монтгомери
+};
+
+using MontgomeryContext = BasicMontgomeryContext<std::uint64_t>;   ///< Контекст Монтгомери для BigNumber
+using MontgomeryContext32 = BasicMontgomeryContext<std::uint32_t>; ///< Контекст Монтгомери для BigNumber32
+
+extern template class BasicMontgomeryContext<std::uint32_t>;
+extern template class BasicMontgomeryContext<std::uint64_t>;
+
+} // namespace big_number
+
+#endif // BIG_NUMBER_MONTGOMERY_HPP
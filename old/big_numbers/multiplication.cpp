@@ -0,0 +1,663 @@
+#include "multiplication.hpp"
+#include "big_number.hpp"
+#include "limb_kernels.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+static_assert(BIG_NUMBER_KARATSUBA_THRESHOLD >= 8, "Порог Карацубы слишком мал для разбиения на половины");
+static_assert(BIG_NUMBER_TOOM3_THRESHOLD >= BIG_NUMBER_KARATSUBA_THRESHOLD, "Тоом-3 должен включаться после Карацубы");
+static_assert(BIG_NUMBER_NTT_THRESHOLD >= BIG_NUMBER_KARATSUBA_THRESHOLD, "NTT не должно заменять школьное умножение");
+
+namespace big_number
+{
+namespace multiplication
+{
+namespace
+{
+constexpr int KARATSUBA_THRESHOLD = BIG_NUMBER_KARATSUBA_THRESHOLD;
+constexpr int TOOM3_THRESHOLD = BIG_NUMBER_TOOM3_THRESHOLD;
+constexpr int NTT_THRESHOLD = BIG_NUMBER_NTT_THRESHOLD;
+
+using kernels::AddN;
+using kernels::SubN;
+
+// r += a с распространением переноса до конца r (rLength >= aLength), возвращает перенос из r
+template <typename Limb> Limb AddTo(Limb *r, int rLength, const Limb *a, int aLength)
+{
+    Limb carry = AddN(r, r, a, aLength);
+    for (int i = aLength; carry != 0 && i < rLength; ++i)
+        carry = ++r[i] == 0;
+    return carry;
+}
+
+// r -= a с распространением заема до конца r (rLength >= aLength), возвращает заем из r
+template <typename Limb> Limb SubFrom(Limb *r, int rLength, const Limb *a, int aLength)
+{
+    Limb borrow = SubN(r, r, a, aLength);
+    for (int i = aLength; borrow != 0 && i < rLength; ++i)
+        borrow = r[i]-- == 0;
+    return borrow;
+}
+
+// r = a << shift (0 < shift < разрядности), возвращает выдвинутые старшие биты
+template <typename Limb> Limb ShiftLeft(Limb *r, const Limb *a, int n, int shift)
+{
+    constexpr int bits = sizeof(Limb) * 8;
+    Limb out = 0;
+    for (int i = 0; i < n; ++i)
+    {
+        Limb value = a[i];
+        r[i] = (value << shift) | out;
+        out = value >> (bits - shift);
+    }
+    return out;
+}
+
+// d = |x - y|, где x длины n, y длины m <= n; возвращает true, если x < y
+template <typename Limb> bool AbsDiff(Limb *d, const Limb *x, int n, const Limb *y, int m)
+{
+    bool less = false;
+    int i = n - 1;
+    for (; i >= m && x[i] == 0; --i)
+    {
+    }
+    if (i < m)
+    {
+        for (; i >= 0 && x[i] == y[i]; --i)
+        {
+        }
+        less = i >= 0 && x[i] < y[i];
+    }
+    if (less)
+    {
+        SubN(d, y, x, m);
+        std::fill(d + m, d + n, Limb(0));
+    }
+    else
+    {
+        std::copy(x, x + n, d);
+        SubFrom(d, n, y, m);
+    }
+    return less;
+}
+
+// Дополнительный код: x = -x по модулю B^n
+template <typename Limb> void Negate(Limb *x, int n)
+{
+    Limb carry = 1;
+    for (int i = 0; i < n; ++i)
+    {
+        x[i] = ~x[i] + carry;
+        carry = carry && x[i] == 0;
+    }
+}
+
+// Арифметический сдвиг вправо на 1 бит числа в дополнительном коде
+template <typename Limb> void ShiftRightSigned1(Limb *x, int n)
+{
+    constexpr int bits = sizeof(Limb) * 8;
+    for (int i = 0; i < n - 1; ++i)
+        x[i] = (x[i] >> 1) | (x[i + 1] << (bits - 1));
+    x[n - 1] = (x[n - 1] >> 1) | (x[n - 1] & (Limb(1) << (bits - 1)));
+}
+
+// Точное деление на 3 числа в дополнительном коде (умножение на 3^(-1) по модулю B^n)
+template <typename Limb> void DivideExactBy3(Limb *x, int n)
+{
+    constexpr Limb inverse = static_cast<Limb>(0xAAAAAAAAAAAAAAABull); // 3 * inverse = 1 mod B
+    constexpr Limb oneThird = static_cast<Limb>(~Limb(0)) / 3 + 1;     // ceil(B / 3)
+    constexpr Limb twoThirds = 2 * (static_cast<Limb>(~Limb(0)) / 3) + 1;
+    Limb carry = 0;
+    for (int i = 0; i < n; ++i)
+    {
+        Limb value = x[i];
+        Limb reduced = value - carry;
+        carry = reduced > value;
+        Limb quotient = reduced * inverse;
+        x[i] = quotient;
+        carry += (quotient >= oneThird) + (quotient >= twoThirds);
+    }
+}
+
+// Объем рабочего буфера (в коэффициентах) для MultiplyBalanced длины n
+std::size_t ScratchSize(int n)
+{
+    if (n < KARATSUBA_THRESHOLD)
+        return 0;
+    if (n < TOOM3_THRESHOLD)
+    {
+        int k = (n + 1) / 2;
+        return 6 * static_cast<std::size_t>(k) + 1 + std::max(ScratchSize(k), ScratchSize(n - k));
+    }
+    int k = (n + 2) / 3;
+    return 8 * static_cast<std::size_t>(k + 1) + 3 * static_cast<std::size_t>(2 * k + 2) +
+           std::max({ScratchSize(k + 1), ScratchSize(k), ScratchSize(n - 2 * k)});
+}
+
+template <typename Limb> void MultiplyBalanced(Limb *r, const Limb *a, const Limb *b, int n, Limb *scratch);
+
+// Карацуба (вычитательный вариант): a*b = z0 + (z0 + z2 - (a0 - a1)(b0 - b1)) B^k + z2 B^2k
+template <typename Limb> void Karatsuba(Limb *r, const Limb *a, const Limb *b, int n, Limb *scratch)
+{
+    const int k = (n + 1) / 2;
+    const int h = n - k;
+    Limb *da = scratch;
+    Limb *db = da + k;
+    Limb *middle = db + k;              // 2k + 1 коэффициентов
+    Limb *product = middle + 2 * k + 1; // 2k коэффициентов
+    Limb *next = product + 2 * k;
+
+    // При возведении в квадрат (a == b) все три произведения тоже являются квадратами
+    const bool negativeA = AbsDiff(da, a, k, a + k, h);
+    const bool negativeB = a == b ? negativeA : AbsDiff(db, b, k, b + k, h);
+    if (a == b)
+        db = da;
+
+    MultiplyBalanced(r, a, b, k, next);
+    MultiplyBalanced(r + 2 * k, a + k, b + k, h, next);
+    MultiplyBalanced(product, da, db, k, next);
+
+    std::copy(r, r + 2 * k, middle);
+    middle[2 * k] = 0;
+    AddTo(middle, 2 * k + 1, r + 2 * k, 2 * h);
+    if (negativeA == negativeB)
+        SubFrom(middle, 2 * k + 1, product, 2 * k);
+    else
+        AddTo(middle, 2 * k + 1, product, 2 * k);
+
+    AddTo(r + k, 2 * n - k, middle, std::min(2 * k + 1, 2 * n - k));
+}
+
+// Значения многочлена a0 + a1 x + a2 x^2 в точках 1, -1, -2 (для -1 и -2 — модуль и знак)
+template <typename Limb>
+void ToomEvaluate(const Limb *a, int k, int h, Limb *at1, Limb *atMinus1, bool &negative1, Limb *atMinus2,
+                  bool &negative2, Limb *temp)
+{
+    const Limb *a0 = a;
+    const Limb *a1 = a + k;
+    const Limb *a2 = a + 2 * k;
+    Limb *even = temp;            // a0 + a2, затем a0 + 4 a2
+    Limb *doubled = temp + k + 1; // 2 a1
+
+    // a0 + a2
+    std::copy(a0, a0 + k, even);
+    even[k] = 0;
+    AddTo(even, k + 1, a2, h);
+
+    // p(1) = a0 + a1 + a2, p(-1) = a0 + a2 - a1
+    std::copy(even, even + k + 1, at1);
+    AddTo(at1, k + 1, a1, k);
+    negative1 = AbsDiff(atMinus1, even, k + 1, a1, k);
+
+    // p(-2) = (a0 + 4 a2) - 2 a1
+    std::fill(even, even + k + 1, Limb(0));
+    even[h] = ShiftLeft(even, a2, h, 2);
+    AddTo(even, k + 1, a0, k);
+    doubled[k] = ShiftLeft(doubled, a1, k, 1);
+    negative2 = AbsDiff(atMinus2, even, k + 1, doubled, k + 1);
+}
+
+// Тоом-3: значения в точках 0, 1, -1, -2, бесконечность и интерполяция Бодрато
+template <typename Limb> void Toom3(Limb *r, const Limb *a, const Limb *b, int n, Limb *scratch)
+{
+    const int k = (n + 2) / 3;
+    const int h = n - 2 * k;
+    const int width = 2 * k + 2; // ширина промежуточных значений в дополнительном коде
+
+    Limb *a1 = scratch;
+    Limb *aMinus1 = a1 + (k + 1);
+    Limb *aMinus2 = aMinus1 + (k + 1);
+    Limb *b1 = aMinus2 + (k + 1);
+    Limb *bMinus1 = b1 + (k + 1);
+    Limb *bMinus2 = bMinus1 + (k + 1);
+    Limb *temp = bMinus2 + (k + 1); // 2 (k + 1)
+    Limb *v1 = temp + 2 * (k + 1);
+    Limb *vMinus1 = v1 + width;
+    Limb *vMinus2 = vMinus1 + width;
+    Limb *next = vMinus2 + width;
+
+    bool aNegative1, aNegative2, bNegative1, bNegative2;
+    ToomEvaluate(a, k, h, a1, aMinus1, aNegative1, aMinus2, aNegative2, temp);
+    if (a == b)
+    {
+        // Возведение в квадрат: значения второго сомножителя совпадают с первыми
+        b1 = a1;
+        bMinus1 = aMinus1;
+        bMinus2 = aMinus2;
+        bNegative1 = aNegative1;
+        bNegative2 = aNegative2;
+    }
+    else
+    {
+        ToomEvaluate(b, k, h, b1, bMinus1, bNegative1, bMinus2, bNegative2, temp);
+    }
+
+    MultiplyBalanced(v1, a1, b1, k + 1, next);
+    MultiplyBalanced(vMinus1, aMinus1, bMinus1, k + 1, next);
+    if (aNegative1 != bNegative1)
+        Negate(vMinus1, width);
+    MultiplyBalanced(vMinus2, aMinus2, bMinus2, k + 1, next);
+    if (aNegative2 != bNegative2)
+        Negate(vMinus2, width);
+
+    // v(0) и v(inf) сразу ложатся на свои места в результате
+    Limb *v0 = r;
+    Limb *vInf = r + 4 * k;
+    MultiplyBalanced(v0, a, b, k, next);
+    std::fill(r + 2 * k, r + 4 * k, Limb(0));
+    MultiplyBalanced(vInf, a + 2 * k, b + 2 * k, h, next);
+
+    // r3 = (v(-2) - v(1)) / 3
+    SubN(vMinus2, vMinus2, v1, width);
+    DivideExactBy3(vMinus2, width);
+    // r1 = (v(1) - v(-1)) / 2
+    SubN(v1, v1, vMinus1, width);
+    ShiftRightSigned1(v1, width);
+    // r2 = v(-1) - v(0)
+    SubFrom(vMinus1, width, v0, 2 * k);
+    // r3 = (r2 - r3) / 2 + 2 v(inf)
+    SubN(vMinus2, vMinus1, vMinus2, width);
+    ShiftRightSigned1(vMinus2, width);
+    AddTo(vMinus2, width, vInf, 2 * h);
+    AddTo(vMinus2, width, vInf, 2 * h);
+    // r2 = r2 + r1 - v(inf)
+    AddN(vMinus1, vMinus1, v1, width);
+    SubFrom(vMinus1, width, vInf, 2 * h);
+    // r1 = r1 - r3
+    SubN(v1, v1, vMinus2, width);
+
+    // Все коэффициенты теперь неотрицательны; переносы за пределы 2n коэффициентов отбрасываются
+    AddTo(r + k, 2 * n - k, v1, std::min(width, 2 * n - k));
+    AddTo(r + 2 * k, 2 * n - 2 * k, vMinus1, std::min(width, 2 * n - 2 * k));
+    AddTo(r + 3 * k, 2 * n - 3 * k, vMinus2, std::min(width, 2 * n - 3 * k));
+}
+
+// Простое p = c * 2^k + 1 с первообразным корнем g; все три меньше 2^62
+struct NttPrime
+{
+    std::uint64_t modulus;
+    std::uint64_t root;
+};
+
+constexpr NttPrime NTT_PRIMES[3] = {
+    {4179340454199820289ull, 3}, // 29 * 2^57 + 1
+    {2485986994308513793ull, 5}, // 69 * 2^55 + 1
+    {1945555039024054273ull, 5}, // 27 * 2^56 + 1
+};
+constexpr int NTT_MAX_LOG_LENGTH = 55; // наименьшая степень двойки в p - 1
+
+// Арифметика по модулю NTT-простого в форме Монтгомери (R = 2^64)
+class NttField
+{
+  public:
+    explicit NttField(std::uint64_t modulus) : modulus_(modulus), twiceModulus_(2 * modulus)
+    {
+        std::uint64_t inverse = modulus; // верны 3 младших бита, каждая итерация Ньютона удваивает их число
+        for (int i = 0; i < 5; ++i)
+            inverse *= 2 - modulus * inverse;
+        negInverse_ = ~inverse + 1;
+        const std::uint64_t r = (~modulus + 1) % modulus;
+        rSquared_ = static_cast<std::uint64_t>(static_cast<unsigned __int128>(r) * r % modulus);
+    }
+
+    std::uint64_t Modulus() const
+    {
+        return modulus_;
+    }
+
+    std::uint64_t TwiceModulus() const
+    {
+        return twiceModulus_;
+    }
+
+    // a * b * R^(-1) mod p в диапазоне [0, 2p); требуется a * b < 2^64 * p
+    std::uint64_t MultiplyLazy(std::uint64_t a, std::uint64_t b) const
+    {
+        unsigned __int128 t = static_cast<unsigned __int128>(a) * b;
+        std::uint64_t m = static_cast<std::uint64_t>(t) * negInverse_;
+        return static_cast<std::uint64_t>((t + static_cast<unsigned __int128>(m) * modulus_) >> 64);
+    }
+
+    // a * b * R^(-1) mod p в диапазоне [0, p)
+    std::uint64_t Multiply(std::uint64_t a, std::uint64_t b) const
+    {
+        std::uint64_t u = MultiplyLazy(a, b);
+        return u >= modulus_ ? u - modulus_ : u;
+    }
+
+    std::uint64_t Sub(std::uint64_t a, std::uint64_t b) const
+    {
+        return a >= b ? a - b : a + modulus_ - b;
+    }
+
+    std::uint64_t ToMontgomery(std::uint64_t a) const
+    {
+        return Multiply(a, rSquared_);
+    }
+
+    // base^exp для base в форме Монтгомери
+    std::uint64_t Pow(std::uint64_t base, std::uint64_t exp) const
+    {
+        std::uint64_t result = ToMontgomery(1);
+        for (; exp != 0; exp >>= 1)
+        {
+            if (exp & 1)
+                result = Multiply(result, base);
+            base = Multiply(base, base);
+        }
+        return result;
+    }
+
+  private:
+    std::uint64_t modulus_;
+    std::uint64_t twiceModulus_;
+    std::uint64_t negInverse_; ///< -p^(-1) mod 2^64
+    std::uint64_t rSquared_;   ///< R^2 mod p
+};
+
+// Таблица корней: roots[half + j] = w^j, где w — первообразный корень степени 2 * half
+std::vector<std::uint64_t> NttRoots(const NttField &field, std::uint64_t root, std::size_t n, bool inverse)
+{
+    std::vector<std::uint64_t> roots(std::max<std::size_t>(n, 2));
+    std::uint64_t omega = field.Pow(field.ToMontgomery(root), (field.Modulus() - 1) / n);
+    if (inverse)
+        omega = field.Pow(omega, n - 1);
+    const std::size_t top = std::max<std::size_t>(n / 2, 1);
+    roots[top] = field.ToMontgomery(1);
+    for (std::size_t j = 1; j < top; ++j)
+        roots[top + j] = field.Multiply(roots[top + j - 1], omega);
+    for (std::size_t half = top / 2; half >= 1; half /= 2)
+    {
+        for (std::size_t j = 0; j < half; ++j)
+            roots[half + j] = roots[2 * half + 2 * j];
+    }
+    return roots;
+}
+
+// Прямое преобразование с прореживанием по частоте: естественный порядок на входе,
+// бит-реверсный на выходе. Значения хранятся с ленивой редукцией в диапазоне [0, 2p).
+void NttForward(std::uint64_t *values, std::size_t n, const NttField &field, const std::vector<std::uint64_t> &roots)
+{
+    const std::uint64_t twiceModulus = field.TwiceModulus();
+    for (std::size_t len = n; len >= 2; len /= 2)
+    {
+        const std::size_t half = len / 2;
+        const std::uint64_t *w = roots.data() + half;
+        for (std::size_t start = 0; start < n; start += len)
+        {
+            std::uint64_t *x = values + start;
+            std::uint64_t *y = x + half;
+            for (std::size_t j = 0; j < half; ++j)
+            {
+                std::uint64_t u = x[j];
+                std::uint64_t v = y[j];
+                std::uint64_t sum = u + v;
+                x[j] = sum >= twiceModulus ? sum - twiceModulus : sum;
+                y[j] = field.MultiplyLazy(u + twiceModulus - v, w[j]);
+            }
+        }
+    }
+}
+
+// Обратное преобразование с прореживанием по времени: бит-реверсный порядок на входе,
+// естественный на выходе; деление на n выполняет вызывающий код
+void NttInverse(std::uint64_t *values, std::size_t n, const NttField &field, const std::vector<std::uint64_t> &roots)
+{
+    const std::uint64_t twiceModulus = field.TwiceModulus();
+    for (std::size_t len = 2; len <= n; len *= 2)
+    {
+        const std::size_t half = len / 2;
+        const std::uint64_t *w = roots.data() + half;
+        for (std::size_t start = 0; start < n; start += len)
+        {
+            std::uint64_t *x = values + start;
+            std::uint64_t *y = x + half;
+            for (std::size_t j = 0; j < half; ++j)
+            {
+                std::uint64_t u = x[j] >= twiceModulus ? x[j] - twiceModulus : x[j];
+                std::uint64_t v = field.MultiplyLazy(y[j], w[j]);
+                std::uint64_t sum = u + v;
+                std::uint64_t diff = u + twiceModulus - v;
+                x[j] = sum >= twiceModulus ? sum - twiceModulus : sum;
+                y[j] = diff >= twiceModulus ? diff - twiceModulus : diff;
+            }
+        }
+    }
+}
+
+// Коэффициенты переводятся в форму Монтгомери (64-битный коэффициент может быть больше p)
+template <typename Limb>
+void NttLoad(std::vector<std::uint64_t> &values, const Limb *a, int length, std::size_t size, const NttField &field)
+{
+    values.assign(size, 0);
+    for (int i = 0; i < length; ++i)
+        values[i] = field.ToMontgomery(a[i]);
+}
+
+// Свертка по трем простым, восстановление коэффициентов по Гарнеру и распространение переносов.
+// При square == true второй сомножитель не используется и выполняется только одно прямое преобразование.
+template <typename Limb>
+void MultiplyNtt(Limb *result, const Limb *a, int aLength, const Limb *b, int bLength, bool square)
+{
+    constexpr int bits = sizeof(Limb) * 8;
+    const std::size_t convolutionLength = static_cast<std::size_t>(aLength) + bLength - 1;
+    std::size_t size = 1;
+    int logSize = 0;
+    while (size < convolutionLength)
+    {
+        size <<= 1;
+        ++logSize;
+    }
+    if (logSize > NTT_MAX_LOG_LENGTH)
+        throw std::length_error("Operands are too long for NTT multiplication.");
+
+    std::vector<std::uint64_t> residues[3];
+    std::vector<std::uint64_t> other;
+    for (int k = 0; k < 3; ++k)
+    {
+        const NttField field(NTT_PRIMES[k].modulus);
+        const std::uint64_t modulus = field.Modulus();
+        std::vector<std::uint64_t> &values = residues[k];
+        NttLoad(values, a, aLength, size, field);
+        const std::vector<std::uint64_t> roots = NttRoots(field, NTT_PRIMES[k].root, size, false);
+        NttForward(values.data(), size, field, roots);
+        if (square)
+        {
+            for (auto &value : values)
+                value = field.MultiplyLazy(value, value);
+        }
+        else
+        {
+            NttLoad(other, b, bLength, size, field);
+            NttForward(other.data(), size, field, roots);
+            for (std::size_t i = 0; i < size; ++i)
+                values[i] = field.MultiplyLazy(values[i], other[i]);
+        }
+        NttInverse(values.data(), size, field, NttRoots(field, NTT_PRIMES[k].root, size, true));
+
+        // Умножение на обычное (не Монтгомери) n^(-1) одновременно выводит значения из формы Монтгомери
+        const std::uint64_t sizeInverse = field.Multiply(field.Pow(field.ToMontgomery(size % modulus), modulus - 2), 1);
+        for (auto &value : values)
+            value = field.Multiply(value, sizeInverse);
+    }
+
+    // Константы Гарнера в форме Монтгомери: Multiply(x, c) дает x * c mod p в обычной форме
+    const std::uint64_t p1 = NTT_PRIMES[0].modulus;
+    const std::uint64_t p2 = NTT_PRIMES[1].modulus;
+    const NttField field2(p2), field3(NTT_PRIMES[2].modulus);
+    const std::uint64_t p3 = field3.Modulus();
+    const std::uint64_t p1InvModP2 = field2.Pow(field2.ToMontgomery(p1 % p2), p2 - 2);
+    const std::uint64_t p1InvModP3 = field3.Pow(field3.ToMontgomery(p1 % p3), p3 - 2);
+    const std::uint64_t p2InvModP3 = field3.Pow(field3.ToMontgomery(p2 % p3), p3 - 2);
+    const unsigned __int128 p1p2 = static_cast<unsigned __int128>(p1) * p2;
+
+    // Накопитель переноса из трех 64-битных слов (младшее первым)
+    std::uint64_t carry[3] = {0, 0, 0};
+    const int total = aLength + bLength;
+    for (int i = 0; i < total; ++i)
+    {
+        if (static_cast<std::size_t>(i) < convolutionLength)
+        {
+            const std::uint64_t r1 = residues[0][i];
+            const std::uint64_t v2 = field2.Multiply(field2.Sub(residues[1][i], r1 % p2), p1InvModP2);
+            const std::uint64_t t3 = field3.Multiply(field3.Sub(residues[2][i], r1 % p3), p1InvModP3);
+            const std::uint64_t v3 = field3.Multiply(field3.Sub(t3, v2 % p3), p2InvModP3);
+
+            // x = r1 + p1 * v2 + p1 * p2 * v3 < p1 * p2 * p3 < 2^184
+            unsigned __int128 low = static_cast<unsigned __int128>(p1) * v2 + r1;
+            unsigned __int128 mid = static_cast<unsigned __int128>(static_cast<std::uint64_t>(p1p2)) * v3;
+            unsigned __int128 high = static_cast<unsigned __int128>(static_cast<std::uint64_t>(p1p2 >> 64)) * v3;
+
+            unsigned __int128 word = static_cast<unsigned __int128>(carry[0]) + static_cast<std::uint64_t>(low) +
+                                     static_cast<std::uint64_t>(mid);
+            carry[0] = static_cast<std::uint64_t>(word);
+            word = (word >> 64) + carry[1] + static_cast<std::uint64_t>(low >> 64) +
+                   static_cast<std::uint64_t>(mid >> 64) + static_cast<std::uint64_t>(high);
+            carry[1] = static_cast<std::uint64_t>(word);
+            carry[2] += static_cast<std::uint64_t>(word >> 64) + static_cast<std::uint64_t>(high >> 64);
+        }
+        result[i] = static_cast<Limb>(carry[0]);
+        if constexpr (bits == 64)
+        {
+            carry[0] = carry[1];
+            carry[1] = carry[2];
+            carry[2] = 0;
+        }
+        else
+        {
+            carry[0] = (carry[0] >> bits) | (carry[1] << (64 - bits));
+            carry[1] = (carry[1] >> bits) | (carry[2] << (64 - bits));
+            carry[2] >>= bits;
+        }
+    }
+}
+
+// Умножение сомножителей одинаковой длины n; результат занимает 2n коэффициентов
+template <typename Limb> void MultiplyBalanced(Limb *r, const Limb *a, const Limb *b, int n, Limb *scratch)
+{
+    if (n < KARATSUBA_THRESHOLD && a == b)
+        SquareBasecase(r, a, n);
+    else if (n < KARATSUBA_THRESHOLD)
+        MultiplyBasecase(r, a, n, b, n);
+    else if (n < TOOM3_THRESHOLD)
+        Karatsuba(r, a, b, n, scratch);
+    else
+        Toom3(r, a, b, n, scratch);
+}
+} // namespace
+
+template <typename Limb> void MultiplyBasecase(Limb *result, const Limb *a, int aLength, const Limb *b, int bLength)
+{
+    if (bLength == 0)
+    {
+        std::fill(result, result + aLength, Limb(0));
+        return;
+    }
+    // Первая строка записывается умножением, остальные прибавляются со сдвигом на строку
+    result[aLength] = kernels::Mul1(result, a, aLength, b[0]);
+    for (int j = 1; j < bLength; ++j)
+        result[aLength + j] = kernels::AddMul1(result + j, a, aLength, b[j]);
+}
+
+template <typename Limb> void SquareBasecase(Limb *result, const Limb *a, int length)
+{
+    using DoubleLimb = typename LimbTraits<Limb>::DoubleType;
+    constexpr int bits = sizeof(Limb) * 8;
+
+    // Недиагональные произведения a[i] * a[j], i < j, считаются один раз
+    std::fill(result, result + 2 * length, Limb(0));
+    for (int i = 0; i < length; ++i)
+        result[i + length] = kernels::AddMul1(result + 2 * i + 1, a + i + 1, length - i - 1, a[i]);
+
+    // Удвоение сдвигом на один бит и прибавление диагонали a[i]^2
+    ShiftLeft(result, result, 2 * length, 1);
+    Limb carry = 0;
+    for (int i = 0; i < length; ++i)
+    {
+        DoubleLimb square = static_cast<DoubleLimb>(a[i]) * a[i];
+        DoubleLimb low = static_cast<DoubleLimb>(result[2 * i]) + static_cast<Limb>(square) + carry;
+        result[2 * i] = static_cast<Limb>(low);
+        DoubleLimb high = static_cast<DoubleLimb>(result[2 * i + 1]) + static_cast<Limb>(square >> bits) +
+                          static_cast<Limb>(low >> bits);
+        result[2 * i + 1] = static_cast<Limb>(high);
+        carry = static_cast<Limb>(high >> bits);
+    }
+}
+
+template <typename Limb> void Multiply(Limb *result, const Limb *a, int aLength, const Limb *b, int bLength)
+{
+    if (aLength < bLength)
+    {
+        std::swap(a, b);
+        std::swap(aLength, bLength);
+    }
+    if (a == b && aLength == bLength)
+    {
+        Square(result, a, aLength);
+        return;
+    }
+    if (bLength < KARATSUBA_THRESHOLD)
+    {
+        MultiplyBasecase(result, a, aLength, b, bLength);
+        return;
+    }
+    if (bLength >= NTT_THRESHOLD)
+    {
+        MultiplyNtt(result, a, aLength, b, bLength, false);
+        return;
+    }
+
+    ScratchVector<Limb> scratch(ScratchSize(bLength) + (aLength == bLength ? 0 : 2 * static_cast<std::size_t>(bLength)));
+    if (aLength == bLength)
+    {
+        MultiplyBalanced(result, a, b, bLength, scratch.data());
+        return;
+    }
+
+    // Несимметричный случай: длинный сомножитель режется на куски длины короткого
+    Limb *chunk = scratch.data();
+    Limb *next = chunk + 2 * bLength;
+    const int total = aLength + bLength;
+    std::fill(result, result + total, Limb(0));
+    for (int offset = 0; offset < aLength; offset += bLength)
+    {
+        const int length = std::min(bLength, aLength - offset);
+        if (length == bLength)
+            MultiplyBalanced(chunk, a + offset, b, bLength, next);
+        else
+            Multiply(chunk, b, bLength, a + offset, length);
+        AddTo(result + offset, total - offset, chunk, length + bLength);
+    }
+}
+
+template <typename Limb> void Square(Limb *result, const Limb *a, int length)
+{
+    if (length >= NTT_THRESHOLD)
+    {
+        MultiplyNtt(result, a, length, a, length, true);
+    }
+    else if (length < KARATSUBA_THRESHOLD)
+    {
+        SquareBasecase(result, a, length);
+    }
+    else
+    {
+        ScratchVector<Limb> scratch(ScratchSize(length));
+        MultiplyBalanced(result, a, a, length, scratch.data());
+    }
+}
+
+template void MultiplyBasecase<std::uint32_t>(std::uint32_t *, const std::uint32_t *, int, const std::uint32_t *, int);
+template void MultiplyBasecase<std::uint64_t>(std::uint64_t *, const std::uint64_t *, int, const std::uint64_t *, int);
+template void SquareBasecase<std::uint32_t>(std::uint32_t *, const std::uint32_t *, int);
+template void SquareBasecase<std::uint64_t>(std::uint64_t *, const std::uint64_t *, int);
+template void Multiply<std::uint32_t>(std::uint32_t *, const std::uint32_t *, int, const std::uint32_t *, int);
+template void Multiply<std::uint64_t>(std::uint64_t *, const std::uint64_t *, int, const std::uint64_t *, int);
+template void Square<std::uint32_t>(std::uint32_t *, const std::uint32_t *, int);
+template void Square<std::uint64_t>(std::uint64_t *, const std::uint64_t *, int);
+
+} // namespace multiplication
+} // namespace big_number
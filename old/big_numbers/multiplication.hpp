@@ -0,0 +1,69 @@
+#ifndef MULTIPLICATION_HPP
+#define MULTIPLICATION_HPP
+
+/// Длина сомножителей (в коэффициентах), начиная с которой применяется алгоритм Карацубы
+#ifndef BIG_NUMBER_KARATSUBA_THRESHOLD
+#define BIG_NUMBER_KARATSUBA_THRESHOLD 32
+#endif
+
+/// Длина сомножителей (в коэффициентах), начиная с которой применяется алгоритм Тоома-Кука (Тоом-3)
+#ifndef BIG_NUMBER_TOOM3_THRESHOLD
+#define BIG_NUMBER_TOOM3_THRESHOLD 96
+#endif
+
+/// Длина более короткого сомножителя (в коэффициентах), начиная с которой применяется NTT
+#ifndef BIG_NUMBER_NTT_THRESHOLD
+#define BIG_NUMBER_NTT_THRESHOLD 2048
+#endif
+
+namespace big_number
+{
+namespace multiplication
+{
+/// @brief Школьное умножение массивов коэффициентов
+/// @param[out] result Массив длины aLength + bLength, не пересекающийся с a и b
+/// @param[in] a Первый сомножитель (младший коэффициент первым)
+/// @param[in] aLength Длина первого сомножителя
+/// @param[in] b Второй сомножитель
+/// @param[in] bLength Длина второго сомножителя
+template <typename Limb> void MultiplyBasecase(Limb *result, const Limb *a, int aLength, const Limb *b, int bLength);
+
+/// @brief Школьное возведение в квадрат
+///
+/// Каждое недиагональное произведение a[i] * a[j] (i < j) вычисляется один раз,
+/// сумма удваивается сдвигом и к ней прибавляются диагональные квадраты a[i]^2.
+/// @param[out] result Массив длины 2 * length, не пересекающийся с a
+/// @param[in] a Число (младший коэффициент первым)
+/// @param[in] length Длина числа
+template <typename Limb> void SquareBasecase(Limb *result, const Limb *a, int length);
+
+/// @brief Умножение массивов коэффициентов с выбором алгоритма по длине
+///
+/// Ниже BIG_NUMBER_KARATSUBA_THRESHOLD используется школьный алгоритм, выше —
+/// рекурсия Карацубы, начиная с BIG_NUMBER_TOOM3_THRESHOLD — Тоом-3, а начиная с
+/// BIG_NUMBER_NTT_THRESHOLD — теоретико-числовое преобразование по трем простым
+/// модулям с восстановлением коэффициентов по китайской теореме об остатках.
+/// Рабочая память для всей рекурсии выделяется одним буфером заранее.
+/// @param[out] result Массив длины aLength + bLength, не пересекающийся с a и b
+/// @param[in] a Первый сомножитель (младший коэффициент первым)
+/// @param[in] aLength Длина первого сомножителя
+/// @param[in] b Второй сомножитель
+/// @param[in] bLength Длина второго сомножителя
+/// @throw std::length_error если сомножители слишком длинные для NTT
+template <typename Limb> void Multiply(Limb *result, const Limb *a, int aLength, const Limb *b, int bLength);
+
+/// @brief Возведение в квадрат массива коэффициентов
+///
+/// Короткие числа возводятся в квадрат SquareBasecase, средние — рекурсией
+/// Карацубы/Тоома-3, в которой все промежуточные произведения тоже квадраты,
+/// длинные — через NTT с одним прямым преобразованием вместо двух.
+/// @param[out] result Массив длины 2 * length, не пересекающийся с a
+/// @param[in] a Число (младший коэффициент первым)
+/// @param[in] length Длина числа
+/// @throw std::length_error если число слишком длинное для NTT
+template <typename Limb> void Square(Limb *result, const Limb *a, int length);
+
+} // namespace multiplication
+} // namespace big_number
+
+#endif // MULTIPLICATION_HPP
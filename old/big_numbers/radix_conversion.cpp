@@ -0,0 +1,262 @@
+#include "radix_conversion.hpp"
+#include "arena.hpp"
+#include "divisor.hpp"
+
+#include <algorithm>
+
+namespace big_number
+{
+namespace
+{
+// Наибольшая степень десяти, помещающаяся в коэффициент: 10^19 или 10^9
+template <typename BaseType> constexpr BaseType ChunkBase()
+{
+    BaseType base = 1;
+    for (int i = 0; i < (sizeof(BaseType) == 8 ? 19 : 9); ++i)
+        base *= 10;
+    return base;
+}
+
+// floor(b^(2k) / p) для числа p длины k коэффициентов. Приближение берется рекурсивно
+// по старшей половине p и уточняется одним шагом Ньютона x = x + x * (b^(2k) - p * x) / b^(2k),
+// который удваивает число верных коэффициентов; остаток погрешности убирается коррекцией.
+// Деление Кнута используется только для коротких чисел, поэтому сложность определяется умножением
+template <typename Limb> BasicBigNumber<Limb> Reciprocal(const BasicBigNumber<Limb> &p)
+{
+    using BigNumber = BasicBigNumber<Limb>;
+    constexpr int bits = BigNumber::BASE_SIZE;
+    const int k = (p.BitLength() + bits - 1) / bits;
+    const BigNumber one(1, 1);
+    const BigNumber power = one << (2 * k * bits);
+    // Старшая часть из h < k коэффициентов существует только при k > 4
+    if (k <= std::max(BIG_NUMBER_RADIX_THRESHOLD, 4))
+        return power / p;
+
+    const int h = k / 2 + 2;
+    BigNumber x = Reciprocal(p >> ((k - h) * bits)) << ((k - h) * bits);
+
+    BigNumber product = p * x;
+    if (product <= power)
+        x += (x * (power - product)) >> (2 * k * bits);
+    else
+        x -= (x * (product - power)) >> (2 * k * bits);
+
+    product = p * x;
+    while (product > power)
+    {
+        x -= one;
+        product -= p;
+    }
+    BigNumber remainder = power - product;
+    while (remainder >= p)
+    {
+        x += one;
+        remainder -= p;
+    }
+    return x;
+}
+} // namespace
+
+template <typename Limb>
+typename BasicDecimalConverter<Limb>::Power &BasicDecimalConverter<Limb>::PowerAt(int level)
+{
+    // Степени кэшируются между вызовами и не должны попасть в арену вызывающего алгоритма
+    HeapScope heap;
+    if (powers_.empty())
+        powers_.push_back({BigNumber(static_cast<unsigned long long>(ChunkBase<BaseType>())), BigNumber()});
+    while (static_cast<int>(powers_.size()) <= level)
+    {
+        const BigNumber &previous = powers_.back().value;
+        powers_.push_back({previous * previous, BigNumber()});
+    }
+    return powers_[level];
+}
+
+// Деление по Барретту (HAC, алгоритм 14.42) с полными произведениями: оба умножения
+// и вычисление обратной величины выполняются быстрыми алгоритмами умножения
+template <typename Limb>
+std::pair<BasicBigNumber<Limb>, BasicBigNumber<Limb>> BasicDecimalConverter<Limb>::DivideByPower(const BigNumber &x,
+                                                                                                 int level)
+{
+    constexpr int bits = BigNumber::BASE_SIZE;
+    Power &power = PowerAt(level);
+    const int k = power.value.length_;
+    if (power.reciprocal.IsZero())
+    {
+        HeapScope heap;
+        power.reciprocal = Reciprocal(power.value);
+    }
+
+    BigNumber quotient = ((x >> ((k - 1) * bits)) * power.reciprocal) >> ((k + 1) * bits);
+    BigNumber remainder = x - quotient * power.value;
+    const BigNumber one(1, 1);
+    while (remainder >= power.value)
+    {
+        remainder -= power.value;
+        quotient += one;
+    }
+    return {std::move(quotient), std::move(remainder)};
+}
+
+template <typename Limb> std::string BasicDecimalConverter<Limb>::ToString(const BigNumber &number)
+{
+    if (number.IsZero())
+        return "0";
+
+    std::string out;
+    out.reserve(static_cast<std::size_t>(number.BitLength()) * 30103 / 100000 + 2);
+    if (number.length_ < BIG_NUMBER_RADIX_THRESHOLD)
+    {
+        ToStringBasecase(number, 0, out);
+        return out;
+    }
+
+    // Наименьший уровень, при котором число меньше квадрата степени
+    int level = 0;
+    while (PowerAt(level + 1).value <= number)
+        ++level;
+    ToStringRecursive(number, level, false, out);
+    return out;
+}
+
+template <typename Limb>
+void BasicDecimalConverter<Limb>::ToStringRecursive(const BigNumber &x, int level, bool pad, std::string &out)
+{
+    if (level == 0 || x.length_ < BIG_NUMBER_RADIX_THRESHOLD)
+    {
+        ToStringBasecase(x, pad ? static_cast<std::size_t>(CHUNK_DIGITS) << (level + 1) : 0, out);
+        return;
+    }
+
+    auto [quotient, remainder] = DivideByPower(x, level);
+    if (!pad && quotient.IsZero())
+    {
+        ToStringRecursive(remainder, level - 1, false, out);
+        return;
+    }
+    ToStringRecursive(quotient, level - 1, pad, out);
+    ToStringRecursive(remainder, level - 1, true, out);
+}
+
+template <typename Limb>
+void BasicDecimalConverter<Limb>::ToStringBasecase(const BigNumber &x, std::size_t width, std::string &out) const
+{
+    static const BasicLimbDivisor<Limb> chunkDivisor(ChunkBase<BaseType>());
+
+    // Блоки по CHUNK_DIGITS цифр, младший первым: одно деление на 10^CHUNK_DIGITS на блок
+    std::vector<BaseType> work(x.coefficients_.data(), x.coefficients_.data() + x.length_);
+    int length = x.length_;
+    std::vector<BaseType> chunks;
+    chunks.reserve(length + length / 8 + 1);
+    while (length > 1 || work[0] != 0)
+    {
+        chunks.push_back(chunkDivisor.Divide(work.data(), work.data(), length));
+        while (length > 1 && work[length - 1] == 0)
+            --length;
+    }
+
+    char buffer[CHUNK_DIGITS];
+    auto format = [&buffer](BaseType value) {
+        for (int i = CHUNK_DIGITS - 1; i >= 0; --i)
+        {
+            buffer[i] = static_cast<char>('0' + value % 10);
+            value /= 10;
+        }
+    };
+
+    std::size_t topDigits = 0;
+    if (!chunks.empty())
+    {
+        format(chunks.back());
+        topDigits = CHUNK_DIGITS;
+        while (topDigits > 1 && buffer[CHUNK_DIGITS - topDigits] == '0')
+            --topDigits;
+    }
+    const std::size_t digits = chunks.empty() ? 0 : (chunks.size() - 1) * CHUNK_DIGITS + topDigits;
+    if (width > digits)
+        out.append(width - digits, '0');
+    else if (chunks.empty())
+        out.push_back('0');
+    if (chunks.empty())
+        return;
+
+    out.append(buffer + CHUNK_DIGITS - topDigits, topDigits);
+    for (auto it = chunks.rbegin() + 1; it != chunks.rend(); ++it)
+    {
+        format(*it);
+        out.append(buffer, CHUNK_DIGITS);
+    }
+}
+
+template <typename Limb> BasicBigNumber<Limb> BasicDecimalConverter<Limb>::FromString(const std::string &digits)
+{
+    for (char ch : digits)
+    {
+        if (ch < '0' || ch > '9')
+            throw std::invalid_argument("Invalid digit in input.");
+    }
+    std::size_t start = 0;
+    while (start < digits.size() && digits[start] == '0')
+        ++start;
+    if (start == digits.size())
+        return BigNumber(1, 0);
+    return FromStringRecursive(digits.data() + start, digits.size() - start);
+}
+
+template <typename Limb>
+BasicBigNumber<Limb> BasicDecimalConverter<Limb>::FromStringRecursive(const char *digits, std::size_t length)
+{
+    if (length <= static_cast<std::size_t>(CHUNK_DIGITS) * BIG_NUMBER_RADIX_THRESHOLD)
+        return FromStringBasecase(digits, length);
+
+    // Младшая часть — ровно CHUNK_DIGITS * 2^level цифр, старшая — не длиннее ее
+    int level = 0;
+    while ((static_cast<std::size_t>(CHUNK_DIGITS) << (level + 1)) < length)
+        ++level;
+    const std::size_t lowLength = static_cast<std::size_t>(CHUNK_DIGITS) << level;
+
+    BigNumber result = FromStringRecursive(digits, length - lowLength);
+    result *= PowerAt(level).value;
+    result += FromStringRecursive(digits + length - lowLength, lowLength);
+    return result;
+}
+
+template <typename Limb>
+BasicBigNumber<Limb> BasicDecimalConverter<Limb>::FromStringBasecase(const char *digits, std::size_t length) const
+{
+    using DoubleBaseType = typename BigNumber::DoubleBaseType;
+    constexpr int bits = BigNumber::BASE_SIZE;
+    constexpr BaseType chunkBase = ChunkBase<BaseType>();
+
+    // Каждый блок из CHUNK_DIGITS цифр добавляется одним проходом result = result * 10^CHUNK_DIGITS + блок
+    const std::size_t chunkCount = (length + CHUNK_DIGITS - 1) / CHUNK_DIGITS;
+    BigNumber result(static_cast<int>(chunkCount) + 1);
+    BaseType *coefficients = result.coefficients_.data();
+    std::size_t position = 0;
+    std::size_t chunkLength = length - (chunkCount - 1) * CHUNK_DIGITS;
+    for (std::size_t chunk = 0; chunk < chunkCount; ++chunk)
+    {
+        BaseType value = 0;
+        for (std::size_t i = 0; i < chunkLength; ++i)
+            value = value * 10 + static_cast<BaseType>(digits[position + i] - '0');
+        position += chunkLength;
+        chunkLength = CHUNK_DIGITS;
+
+        BaseType carry = value;
+        for (int i = 0; i < result.length_; ++i)
+        {
+            DoubleBaseType current = static_cast<DoubleBaseType>(coefficients[i]) * chunkBase + carry;
+            coefficients[i] = static_cast<BaseType>(current);
+            carry = static_cast<BaseType>(current >> bits);
+        }
+        if (carry != 0)
+            coefficients[result.length_++] = carry;
+    }
+    result.NormalizeLength();
+    return result;
+}
+
+template class BasicDecimalConverter<std::uint32_t>;
+template class BasicDecimalConverter<std::uint64_t>;
+
+} // namespace big_number
@@ -0,0 +1,82 @@
+#ifndef RADIX_CONVERSION_HPP
+#define RADIX_CONVERSION_HPP
+
+#include "big_number.hpp"
+
+#include <string>
+#include <vector>
+
+/// Длина числа (в коэффициентах), начиная с которой перевод в десятичный вид идет делением пополам
+#ifndef BIG_NUMBER_RADIX_THRESHOLD
+#define BIG_NUMBER_RADIX_THRESHOLD 32
+#endif
+
+namespace big_number
+{
+/// @brief Перевод больших чисел между двоичным и десятичным представлением
+///
+/// Длинные числа переводятся методом «разделяй и властвуй»: число делится на
+/// степень 10^(d * 2^l), близкую к его квадратному корню, и обе половины
+/// переводятся рекурсивно. Степени и их обратные величины (для деления
+/// по Барретту через быстрое умножение) вычисляются один раз и кэшируются
+/// в объекте. Короткие числа переводятся блоками по d цифр, где 10^d — наибольшая
+/// степень десяти, помещающаяся в коэффициент (19 цифр для 64-битных
+/// коэффициентов, 9 — для 32-битных).
+/// @tparam Limb Тип коэффициента: std::uint32_t или std::uint64_t
+template <typename Limb> class BasicDecimalConverter
+{
+  public:
+    using BigNumber = BasicBigNumber<Limb>;
+    using BaseType = typename BigNumber::BaseType;
+
+    static constexpr int CHUNK_DIGITS = BigNumber::BASE_SIZE == 64 ? 19 : 9; ///< Десятичных цифр в блоке
+
+    /// @brief Переводит число в десятичную строку
+    /// @param[in] number Число
+    /// @return Десятичная запись без ведущих нулей
+    std::string ToString(const BigNumber &number);
+
+    /// @brief Читает число из десятичной строки
+    /// @param[in] digits Строка из цифр '0'–'9' (пустая строка дает ноль)
+    /// @return Прочитанное число
+    /// @throw std::invalid_argument если в строке есть символ, отличный от цифры
+    BigNumber FromString(const std::string &digits);
+
+  private:
+    // Степень 10^(CHUNK_DIGITS * 2^level) и floor(b^(2k) / степень), k — ее длина (вычисляется при первом делении)
+    struct Power
+    {
+        BigNumber value;
+        BigNumber reciprocal;
+    };
+
+    // Возвращает кэшированную степень уровня level, при необходимости достраивая кэш
+    Power &PowerAt(int level);
+
+    // Частное и остаток от деления x < степень^2 на степень уровня level
+    std::pair<BigNumber, BigNumber> DivideByPower(const BigNumber &x, int level);
+
+    // Записывает x < 10^(CHUNK_DIGITS * 2^(level + 1)); при pad дополняет нулями до полной ширины
+    void ToStringRecursive(const BigNumber &x, int level, bool pad, std::string &out);
+
+    // Перевод короткого числа блоками по CHUNK_DIGITS цифр
+    void ToStringBasecase(const BigNumber &x, std::size_t width, std::string &out) const;
+
+    // Читает число из digits[0, length)
+    BigNumber FromStringRecursive(const char *digits, std::size_t length);
+
+    // Чтение короткой строки блоками по CHUNK_DIGITS цифр
+    BigNumber FromStringBasecase(const char *digits, std::size_t length) const;
+
+    std::vector<Power> powers_; ///< Кэш степеней 10^(CHUNK_DIGITS * 2^level)
+};
+
+using DecimalConverter = BasicDecimalConverter<std::uint64_t>;   ///< Перевод в десятичный вид для BigNumber
+using DecimalConverter32 = BasicDecimalConverter<std::uint32_t>; ///< Перевод в десятичный вид для BigNumber32
+
+extern template class BasicDecimalConverter<std::uint32_t>;
+extern template class BasicDecimalConverter<std::uint64_t>;
+
+} // namespace big_number
+
+#endif // RADIX_CONVERSION_HPP
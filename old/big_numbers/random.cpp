@@ -0,0 +1,27 @@
+#include "random.hpp"
+
+#include <functional>
+#include <random>
+#include <thread>
+
+namespace big_number
+{
+namespace
+{
+// random_device может быть детерминированным на некоторых платформах, поэтому
+// к зерну добавляется идентификатор потока: потоки не получат одинаковых последовательностей
+std::uint64_t ThreadSeed()
+{
+    std::random_device device;
+    const std::uint64_t entropy = (static_cast<std::uint64_t>(device()) << 32) | device();
+    return entropy ^ std::hash<std::thread::id>{}(std::this_thread::get_id());
+}
+} // namespace
+
+RandomEngine &RandomEngine::ThreadEngine()
+{
+    thread_local RandomEngine engine(ThreadSeed());
+    return engine;
+}
+
+} // namespace big_number
@@ -0,0 +1,103 @@
+#ifndef BIG_NUMBER_RANDOM_HPP
+#define BIG_NUMBER_RANDOM_HPP
+
+#include <cstdint>
+#include <limits>
+
+namespace big_number
+{
+/// @brief Генератор псевдослучайных чисел xoshiro256** (Blackman, Vigna, 2018)
+///
+/// Один вызов дает 64 случайных бита за несколько сдвигов и сложений, поэтому
+/// массив коэффициентов заполняется за один проход. Состояние инициализируется
+/// из зерна через splitmix64. Генератор не криптографический: он предназначен
+/// для выбора оснований в вероятностных тестах и генерации кандидатов.
+/// Удовлетворяет требованиям UniformRandomBitGenerator.
+class RandomEngine
+{
+  public:
+    using result_type = std::uint64_t;
+
+    explicit RandomEngine(std::uint64_t seed)
+    {
+        Seed(seed);
+    }
+
+    /// @brief Переинициализирует состояние из зерна
+    void Seed(std::uint64_t seed)
+    {
+        for (std::uint64_t &word : state_)
+        {
+            seed += 0x9E3779B97F4A7C15ULL;
+            std::uint64_t z = seed;
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            word = z ^ (z >> 31);
+        }
+    }
+
+    std::uint64_t operator()()
+    {
+        const std::uint64_t result = RotateLeft(state_[1] * 5, 7) * 9;
+        const std::uint64_t t = state_[1] << 17;
+        state_[2] ^= state_[0];
+        state_[3] ^= state_[1];
+        state_[1] ^= state_[2];
+        state_[0] ^= state_[3];
+        state_[2] ^= t;
+        state_[3] = RotateLeft(state_[3], 45);
+        return result;
+    }
+
+    /// @brief Заполняет count коэффициентов случайными битами
+    template <typename Limb> void Fill(Limb *limbs, int count)
+    {
+        if constexpr (sizeof(Limb) == sizeof(std::uint64_t))
+        {
+            for (int i = 0; i < count; ++i)
+                limbs[i] = (*this)();
+        }
+        else
+        {
+            // Одно 64-битное значение на два 32-битных коэффициента
+            int i = 0;
+            for (; i + 1 < count; i += 2)
+            {
+                const std::uint64_t value = (*this)();
+                limbs[i] = static_cast<Limb>(value);
+                limbs[i + 1] = static_cast<Limb>(value >> 32);
+            }
+            if (i < count)
+                limbs[i] = static_cast<Limb>((*this)());
+        }
+    }
+
+    static constexpr result_type min()
+    {
+        return 0;
+    }
+
+    static constexpr result_type max()
+    {
+        return std::numeric_limits<result_type>::max();
+    }
+
+    /// @brief Генератор текущего потока
+    ///
+    /// У каждого потока свое состояние, засеянное из std::random_device и
+    /// идентификатора потока, поэтому параллельные тесты простоты не делят
+    /// состояние и не синхронизируются.
+    static RandomEngine &ThreadEngine();
+
+  private:
+    static std::uint64_t RotateLeft(std::uint64_t x, int k)
+    {
+        return (x << k) | (x >> (64 - k));
+    }
+
+    std::uint64_t state_[4];
+};
+
+} // namespace big_number
+
+#endif // BIG_NUMBER_RANDOM_HPP
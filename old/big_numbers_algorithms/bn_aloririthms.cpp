@@ -1,132 +1,64 @@
+#include "barrett.hpp"
 #include "big_number.hpp"
-
-using big_number::BigNumber;
+#include "big_number_view.hpp"
+#include "generic_algorithms.hpp"
+#include "montgomery.hpp"
+#include "multiplication.hpp"
+#include "random.hpp"
+
+using big_number::BasicBigNumber;
+using big_number::BasicBigNumberView;
+using namespace big_number::literals;
 namespace
 {
-BigNumber Pow(const BigNumber &number, const BigNumber &exp)
+template <typename Limb> BasicBigNumber<Limb> Pow(const BasicBigNumber<Limb> &number, const BasicBigNumber<Limb> &exp)
 {
-    BigNumber result("1");
-    for (big_number::BigNumber i("0"); i < exp; i += BigNumber("1"))
+    using BigNumber = BasicBigNumber<Limb>;
+    const BigNumber one = 1_bn;
+    BigNumber result = one;
+    for (BigNumber i; i < exp; i += one)
     {
-        result = result * number;
+        result *= number;
     }
     return result;
 };
-
-int JacobiNumbers(const BigNumber &a, const BigNumber &n)
-{
-    if (a == BigNumber("0"))
-    {
-        return 0;
-    }
-    if (a == BigNumber("1"))
-    {
-        return 1;
-    }
-    BigNumber k = BigNumber("0");
-    BigNumber a1 = a;
-
-    while (a1 % BigNumber("2") == BigNumber("0"))
-    {
-        a1 = a1 / BigNumber("2");
-        k = k + BigNumber("1");
-    }
-
-    int s;
-    if (k % BigNumber("2") == BigNumber("0"))
-    {
-        s = 1;
-    }
-    else
-    {
-        BigNumber n_mod8 = n % BigNumber("8");
-        if (n_mod8 == BigNumber("1") || n_mod8 == BigNumber("7"))
-        {
-            s = 1;
-        }
-        else
-        {
-            s = -1;
-        }
-    }
-    if (n % BigNumber("4") == BigNumber("3") && a1 % BigNumber("4") == BigNumber("3"))
-    {
-        s = -s;
-    }
-    if (a1 == BigNumber("1"))
-    {
-        return s;
-    }
-    else
-    {
-        return s * JacobiNumbers(n % a1, a1);
-    }
-};
 } // namespace
 
-BigNumber BigNumber::FastSquare()
+template <typename Limb> BasicBigNumber<Limb> BasicBigNumber<Limb>::FastSquare() const
 {
-    // Шаг 1:
-    BigNumber result(2 * length_ + 1);
-    result.length_ = 2 * length_ + 1;
-
-    // Шаг 2
-    for (int i = 0; i < length_; i++)
-    {
-        // 2.1
-        DoubleBaseType doubledTemp =
-            static_cast<DoubleBaseType>(result.coefficients_[2 * i]) +
-            static_cast<DoubleBaseType>(coefficients_[i]) * static_cast<DoubleBaseType>(coefficients_[i]);
-        DoubleBaseType carry = doubledTemp / BASE_SIZE;
-
-        result.coefficients_[2 * i] = static_cast<BaseType>(doubledTemp % BASE_SIZE);
-
-        // 2.2.
-        for (int j = i + 1; j < length_; j++)
-        {
-            FoursBaseType extendedTemp =
-                static_cast<FoursBaseType>(result.coefficients_[i + j]) +
-                static_cast<FoursBaseType>(2) *
-                    (static_cast<FoursBaseType>(coefficients_[i]) * static_cast<FoursBaseType>(coefficients_[j])) +
-                static_cast<FoursBaseType>(carry);
-
-            result.coefficients_[i + j] = static_cast<BaseType>(extendedTemp % BASE_SIZE);
-
-            carry = static_cast<DoubleBaseType>(extendedTemp) / BASE_SIZE;
-        }
-
-        result.coefficients_[i + length_] += static_cast<BaseType>(carry % BASE_SIZE);
-        result.coefficients_[i + length_ + 1] += static_cast<BaseType>(carry / BASE_SIZE);
-    }
-
+    // Недиагональные произведения считаются один раз и удваиваются сдвигом,
+    // для длинных чисел используется квадратичный вариант Карацубы/Тоома-3 или NTT
+    BasicBigNumber result(2 * length_);
+    multiplication::Square(result.coefficients_.data(), coefficients_.data(), length_);
+    result.length_ = 2 * length_;
     result.NormalizeLength();
     return result;
 }
 
-BigNumber BigNumber::DichatomicExponentiation(const BigNumber &exp) const
+template <typename Limb>
+BasicBigNumber<Limb> BasicBigNumber<Limb>::DichatomicExponentiation(const BasicBigNumber &exp) const
 {
-    BigNumber result(1, 1); // Начинаем с 1
-    BigNumber base = *this;
-    BigNumber exponent = exp;
-    BigNumber zero(1, 0);
-    BigNumber one(1, 1);
-    BigNumber two(1, 2);
+    BasicBigNumber result(1, 1); // Начинаем с 1
+    BasicBigNumber base = *this;
+    const int bitLength = exp.BitLength();
 
-    while (exponent != zero)
+    for (int i = 0; i < bitLength; ++i)
     {
-        if (exponent % two == one)
+        if (exp.TestBit(i))
         {
             result *= base;
         }
-        base = base.FastSquare();
-        exponent = exponent / two;
+        if (i + 1 < bitLength)
+        {
+            base = base.FastSquare();
+        }
     }
     return result;
 }
 
-BigNumber BigNumber::BarretAlgo(const BigNumber &m) const
+template <typename Limb> BasicBigNumber<Limb> BasicBigNumber<Limb>::BarretAlgo(const BasicBigNumber &m) const
 {
-    if (m <= BigNumber("0"))
+    if (m.IsZero())
     {
         throw std::invalid_argument("The modulus must be a positive number.");
     }
@@ -134,255 +66,180 @@ BigNumber BigNumber::BarretAlgo(const BigNumber &m) const
     {
         return *this;
     }
-
-    int k = m.length_;
-    if (this->length_ > 2 * k)
+    if (this->length_ > 2 * m.length_)
     {
         throw std::invalid_argument("Invalid data.");
     }
-    BigNumber base("10");
-
-    if (k == 0)
-    {
-        return *this;
-    }
+    // Для многократной редукции по одному модулю выгоднее построить BarrettContext один раз
+    return BasicBarrettContext<Limb>(m).Reduce(*this);
+}
 
-    // Вычисление b^(k)
-    BigNumber base_power_k("1");
-    BigNumber base_bn(base);
+template <typename Limb>
+BasicBigNumber<Limb> BasicBigNumber<Limb>::ModularExponentiation(const BasicBigNumber &exponent,
+                                                                 const BasicBigNumber &modulus) const
+{
+    return ModularExponentiation(*this, exponent, modulus);
+}
 
-    for (int i = 0; i < k; ++i)
+template <typename Limb>
+BasicBigNumber<Limb> BasicBigNumber<Limb>::ModularExponentiation(const BasicBigNumberView<Limb> &base,
+                                                                 const BasicBigNumberView<Limb> &exponent,
+                                                                 const BasicBigNumberView<Limb> &modulus)
+{
+    const BasicBigNumber one = 1_bn;
+    if (modulus.IsZero())
     {
-        base_power_k = base_bn * base_power_k;
-
-        if (base_power_k == BigNumber("0"))
-        {
-            throw std::runtime_error("Exponentiation failed, base_power_k is zero!");
-        }
+        throw std::invalid_argument("The modulus must be a positive number.");
     }
-
-    // Вычисление b^(2k)
-    BigNumber base_power_2k = base_power_k * base_power_k;
-
-    // Вычисление z = (b^(2k) / m)
-    BigNumber z = base_power_2k / m;
-
-    // Вычисление b^(k-1) и b^(k+1)
-    BigNumber b_k_minus_1 = base_power_2k / base;
-    BigNumber b_k_plus_1 = base_power_2k * base;
-
-    if (b_k_plus_1 == BigNumber("0"))
+    if (modulus.IsOne())
     {
-        throw std::runtime_error("Division by zero: b_k_plus_1 is zero!");
+        return BasicBigNumber(1, 0);
     }
-    // Вычисление q' = (x * z) / b^(2k)
-    BigNumber q_prime = (*this * z) / base_power_2k;
-    // BigNumber q_prime = ((*this / b_k_minus_1) * z) / b_k_plus_1;
 
-    // Вычисление r1 и r2
-    BigNumber r1 = *this % b_k_plus_1;
-    BigNumber r2 = (q_prime * m) % b_k_plus_1;
-    BigNumber r = *this - q_prime * m;
-
-    // Инициализация переменной r_
-    BigNumber r_;
-
-    if (r1 >= r2)
-    {
-        r_ = r1 - r2;
-    }
-    else
+    // Нечетный модуль: скользящее окно в форме Монтгомери без выделений памяти в цикле
+    if (modulus.IsOdd())
     {
-        r_ = b_k_plus_1 + r1 - r2;
+        return BasicMontgomeryContext<Limb>(modulus).PowMod(base, exponent);
     }
-    r = r % m;
 
-    while (r_ >= m)
+    // Четный модуль: то же скользящее окно слева направо, каждый шаг редуцируется по Барретту
+    const BaseType *e = exponent.Data();
+    if (exponent.BitLength() == 0)
     {
-        r_ = r_ - m;
+        return one;
     }
-    return r;
-}
+    const int bitLength = exponent.BitLength();
+    auto bit = [e](int i) { return static_cast<unsigned>((e[i / BASE_SIZE] >> (i % BASE_SIZE)) & 1); };
 
-BigNumber BigNumber::ModularExponentiation(const BigNumber &exponent, const BigNumber &modulus) const
-{
-    // Начинаем с result = 1, приводим базу к модулю
-    BigNumber result("0");
-    BigNumber base(*this);
+    const int window = bitLength > 768 ? 6 : (bitLength > 240 ? 5 : (bitLength > 80 ? 4 : (bitLength > 24 ? 3 : 1)));
+    const int tableSize = 1 << (window - 1);
 
-    std::vector<bool> bits = exponent.ToBinary();
-    for (auto bit : bits)
-    {
-        std::cout << bit << " ";
-    }
-    std::cout << "size:" << bits.size() << std::endl;
-    if (bits[bits.size() - 1] == 0)
+    // Нечетные степени base^1, base^3, ..., base^(2^window - 1) по модулю
+    const BasicBarrettContext<Limb> barrett(modulus.ToNumber());
+    std::vector<BasicBigNumber> table(tableSize);
+    table[0] = barrett.Reduce(base.ToNumber());
+    if (tableSize > 1)
     {
-        result = BigNumber("1");
-    }
-    else
-    {
-        result = *this;
+        const BasicBigNumber square = barrett.Square(table[0]);
+        for (int i = 1; i < tableSize; ++i)
+        {
+            table[i] = barrett.Multiply(table[i - 1], square);
+        }
     }
-    std::cout << "\n" << result;
 
-    for (int i = bits.size() - 2; i >= 0; --i)
+    // Пока результат равен единице, возведения в квадрат пропускаются
+    BasicBigNumber result = one;
+    bool started = false;
+    int i = bitLength - 1;
+    while (i >= 0)
     {
-        std::cout << "\n" << base * base;
-        base = base * base;
-        if (bits[i] == 1)
+        if (!bit(i))
         {
-            result = result * base;
+            result = barrett.Square(result);
+            --i;
+            continue;
         }
-        std::cout << "\n" << i << " " << base << " " << result << std::endl;
-    }
-    /*// Проходим по всем битам сверху вниз
-    for (bool bit : bits)
-    {
-
-        if (bit)
+        // Окно [j, i] длины не больше window, заканчивающееся единичным битом
+        int j = std::max(i - window + 1, 0);
+        while (!bit(j))
         {
-            result = (result * base) % modulus;
+            ++j;
         }
-        base = (base * base) % modulus;
-    }*/
-
-    return result % modulus;
-}
-
-std::vector<bool> BigNumber::ToBinary() const
-{
-    std::vector<bool> bits;
-    BigNumber temp = *this;
-
-    while (temp != BigNumber("0"))
-    {
-        bits.insert(bits.begin(), (temp % BigNumber("2")) == BigNumber("1"));
-        temp = (temp) / BigNumber("2");
-    }
-    return bits;
-}
-
-BigNumber BigNumber::Generator(int length, BigNumber startValue, BigNumber endValue)
-{
-    BigNumber number(length);
-
-    number.length_ = length;
-    for (int i = 0; i < number.maxLength_; i++)
-    {
-        number.coefficients_[i] = rand();
-    }
-    if (sizeof(BaseType) == sizeof(unsigned int))
-    { // увеличинная генерация больших чтсел в основании с int
-        for (int i = 0; i < number.maxLength_; ++i)
+        unsigned value = 0;
+        for (int k = i; k >= j; --k)
         {
-            number.coefficients_[i] <<= 16;
-            number.coefficients_[i] |= rand();
+            if (started)
+            {
+                result = barrett.Square(result);
+            }
+            value = (value << 1) | bit(k);
         }
+        result = started ? barrett.Multiply(result, table[value >> 1]) : table[value >> 1];
+        started = true;
+        i = j - 1;
     }
-    number = number % (endValue - startValue + BigNumber("1")) + startValue;
-    return number;
+    return result;
 }
 
-bool BigNumber::FermatTest(size_t reliabilityParameter)
+template <typename Limb> std::vector<bool> BasicBigNumber<Limb>::ToBinary() const
 {
-    if (*this < BigNumber("4"))
-    {
-        throw std::invalid_argument("N must be grater then 3");
-    }
-
-    if (*this % BigNumber("2") == BigNumber("0"))
+    const int bitLength = BitLength();
+    std::vector<bool> bits(bitLength);
+    for (int i = 0; i < bitLength; ++i)
     {
-        return false;
-    }
-    for (size_t i = 0; i < reliabilityParameter; ++i)
-    {
-        auto randBN = Generator(length_, BigNumber("2"), (*this - BigNumber("2")));
-        std::cout << "randGen: " << randBN << " pow: " << (*this - BigNumber("1")) << " mod: " << *this << " equals ->"
-                  << randBN.ModularExponentiation((*this - BigNumber("1")), *this) << std::endl
-                  << std::endl;
-        if (randBN.ModularExponentiation((*this - BigNumber("1")), *this) != BigNumber("1"))
-        {
-            return false;
-        }
+        bits[bitLength - 1 - i] = TestBit(i);
     }
-    return true;
+    return bits;
 }
 
-bool BigNumber::MillerRabinTest(size_t reliabilityParameter)
+// Выборка с отбрасыванием по маске: случайное число из bitLength(range) бит принимается,
+// если не превосходит range. Вероятность принятия больше 1/2, распределение равномерное
+template <typename Limb>
+BasicBigNumber<Limb> BasicBigNumber<Limb>::Generator(int, const BasicBigNumber &startValue,
+                                                     const BasicBigNumber &endValue)
 {
-    if (*this < BigNumber("4"))
-    {
-        throw std::invalid_argument("N must be grater then 3");
-    }
-    if (*this % BigNumber("2") == BigNumber("0"))
+    if (endValue < startValue)
     {
-        return false;
+        throw std::invalid_argument("The range is empty.");
     }
-    BigNumber s("0");
-    BigNumber r = *this - BigNumber("1");
-
-    while (r % BigNumber("2") == BigNumber("0"))
+    const BasicBigNumber range = endValue - startValue;
+    const int bitLength = range.BitLength();
+    if (bitLength == 0)
     {
-        r = r / BigNumber("2");
-        s += BigNumber("1");
+        return startValue;
     }
+    const int length = (bitLength + BASE_SIZE - 1) / BASE_SIZE;
+    const int topBits = bitLength - (length - 1) * BASE_SIZE;
+    const BaseType mask = topBits == BASE_SIZE ? static_cast<BaseType>(~BaseType(0))
+                                               : static_cast<BaseType>((BaseType(1) << topBits) - 1);
 
-    for (size_t i = 0; i < reliabilityParameter; ++i)
+    RandomEngine &engine = RandomEngine::ThreadEngine();
+    BasicBigNumber number(length);
+    do
     {
-        auto randBN = Generator(length_, BigNumber("2"), (*this - BigNumber("2")));
-
-        BigNumber y = randBN.ModularExponentiation(r, *this);
-
-        if (!((y == BigNumber("1")) || (y == *this - BigNumber("1"))))
-        {
-            BigNumber j("1");
-            while (j < s && !(y == *this - BigNumber("1")))
-            {
-                y = y.ModularExponentiation(BigNumber("2"), *this);
-                if (y == BigNumber("1"))
-                {
-                    return false;
-                }
-                j += BigNumber("1");
-            }
-            if (!(y == *this - BigNumber("1")))
-            {
-                return false;
-            }
-        }
-    }
-
-    return true;
+        engine.Fill(number.coefficients_.data(), length);
+        number.coefficients_[length - 1] &= mask;
+        number.length_ = length;
+        number.NormalizeLength();
+    } while (number > range);
+    number += startValue;
+    return number;
 }
 
-bool BigNumber::SoloveyStrassenTest(size_t reliabilityParameter)
+// Тесты простоты — обертки над обобщенными алгоритмами (generic_algorithms.hpp):
+// временные числа раундов берутся из арены потока, степени считаются по Монтгомери
+template <typename Limb> bool BasicBigNumber<Limb>::FermatTest(size_t reliabilityParameter)
 {
-    if (*this < BigNumber("4"))
-    {
-        throw std::invalid_argument("N must be grater then 3");
-    }
-
-    if (*this % BigNumber("2") == BigNumber("0"))
-    {
-        return false;
-    }
-    for (size_t i = 0; i < reliabilityParameter; ++i)
-    {
-        auto randBN = Generator(length_, BigNumber("2"), (*this - BigNumber("2")));
-        auto r = randBN.ModularExponentiation(((*this - BigNumber("1")) / BigNumber("2")), *this);
+    return generic::FermatTest(*this, reliabilityParameter);
+}
 
-        if (!((r == BigNumber("1")) || (r == *this - BigNumber("1"))))
-        {
-            return false;
-        }
-        auto jacobiNumber = JacobiNumbers(randBN, *this);
-        BigNumber s = (jacobiNumber == -1) ? *this - BigNumber("1") : BigNumber(std::to_string(jacobiNumber));
+template <typename Limb> bool BasicBigNumber<Limb>::MillerRabinTest(size_t reliabilityParameter)
+{
+    return generic::MillerRabinTest(*this, reliabilityParameter);
+}
 
-        if (r != s)
-        {
-            return false;
-        }
-    }
-    return true;
+template <typename Limb> bool BasicBigNumber<Limb>::SoloveyStrassenTest(size_t reliabilityParameter)
+{
+    return generic::SoloveyStrassenTest(*this, reliabilityParameter);
 }
+
+// Явные инстанцирования алгоритмов для поддерживаемых типов коэффициентов
+#define BIG_NUMBER_INSTANTIATE_ALGORITHMS(Limb)                                                                        \
+    template BasicBigNumber<Limb> BasicBigNumber<Limb>::FastSquare() const;                                            \
+    template BasicBigNumber<Limb> BasicBigNumber<Limb>::DichatomicExponentiation(const BasicBigNumber &) const;        \
+    template BasicBigNumber<Limb> BasicBigNumber<Limb>::BarretAlgo(const BasicBigNumber &) const;                      \
+    template BasicBigNumber<Limb> BasicBigNumber<Limb>::ModularExponentiation(const BasicBigNumber &,                  \
+                                                                              const BasicBigNumber &) const;           \
+    template BasicBigNumber<Limb> BasicBigNumber<Limb>::ModularExponentiation(                                         \
+        const BasicBigNumberView<Limb> &, const BasicBigNumberView<Limb> &, const BasicBigNumberView<Limb> &);         \
+    template std::vector<bool> BasicBigNumber<Limb>::ToBinary() const;                                                 \
+    template BasicBigNumber<Limb> BasicBigNumber<Limb>::Generator(int, const BasicBigNumber &,                         \
+                                                                  const BasicBigNumber &);                             \
+    template bool BasicBigNumber<Limb>::FermatTest(size_t);                                                            \
+    template bool BasicBigNumber<Limb>::MillerRabinTest(size_t);                                                       \
+    template bool BasicBigNumber<Limb>::SoloveyStrassenTest(size_t);
+
+BIG_NUMBER_INSTANTIATE_ALGORITHMS(std::uint32_t)
+BIG_NUMBER_INSTANTIATE_ALGORITHMS(std::uint64_t)
+
+#undef BIG_NUMBER_INSTANTIATE_ALGORITHMS
@@ -0,0 +1,431 @@
+// Дифференциальный стенд: одни и те же случайные операции выполняются на
+// big_number::BigNumber, big_number::BigNumber32 и boost::multiprecision::cpp_int.
+// Результаты сравниваются между собой, скорость каждой операции выводится
+// в одной таблице. При расхождении печатается зерно случая, по которому он
+// воспроизводится отдельно:
+//
+//   differential_harness [--seed N] [--count N] [--op NAME] [--bits N] [--case-seed N]
+//
+// Код возврата 1, если найдено хотя бы одно расхождение.
+#include "big_number.hpp"
+#include "generic_algorithms.hpp"
+#include "limb_kernels.hpp"
+
+#include <boost/multiprecision/cpp_int.hpp>
+#include <boost/multiprecision/miller_rabin.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+using Words = std::vector<std::uint32_t>; ///< Число в переносимом виде: 32-битные слова, младшее первым
+
+namespace
+{
+enum class Operation
+{
+    Add,
+    Sub,
+    Mul,
+    DivMod,
+    PowModOdd,
+    PowModEven,
+    Jacobi,
+    MillerRabin,
+    SoloveyStrassen,
+};
+
+struct OperationInfo
+{
+    Operation operation;
+    const char *name;
+    int inputs;                      ///< Число операндов
+    std::vector<std::size_t> bits;   ///< Размеры операндов по умолчанию
+    std::size_t workPerCase;         ///< Относительная стоимость: число случаев делится на нее
+};
+
+const std::vector<OperationInfo> &Operations()
+{
+    static const std::vector<OperationInfo> operations = {
+        {Operation::Add, "add", 2, {64, 256, 1024, 4096, 16384}, 1},
+        {Operation::Sub, "sub", 2, {64, 256, 1024, 4096, 16384}, 1},
+        {Operation::Mul, "mul", 2, {64, 256, 1024, 4096, 16384}, 1},
+        {Operation::DivMod, "divmod", 2, {128, 512, 2048, 8192}, 1},
+        {Operation::PowModOdd, "powmod-odd", 3, {64, 256, 1024, 2048}, 64},
+        {Operation::PowModEven, "powmod-even", 3, {64, 256, 1024}, 64},
+        {Operation::Jacobi, "jacobi", 2, {64, 256, 1024, 2048}, 8},
+        {Operation::MillerRabin, "miller-rabin", 1, {64, 256, 512, 1024}, 64},
+        {Operation::SoloveyStrassen, "solovey-strassen", 1, {64, 256, 512}, 64},
+    };
+    return operations;
+}
+
+constexpr std::size_t PRIMALITY_ROUNDS = 16;
+
+// splitmix64: зерно случая из общего зерна, операции, размера и номера
+std::uint64_t Mix(std::uint64_t x)
+{
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+std::uint64_t CaseSeed(std::uint64_t seed, Operation operation, std::size_t bits, std::size_t index)
+{
+    return Mix(Mix(Mix(seed ^ static_cast<std::uint64_t>(operation)) ^ bits) ^ index);
+}
+
+void Normalize(Words &words)
+{
+    while (!words.empty() && words.back() == 0)
+        words.pop_back();
+}
+
+// Случайное число ровно из bits бит
+Words RandomWords(std::mt19937_64 &rng, std::size_t bits)
+{
+    Words words((bits + 31) / 32);
+    for (std::uint32_t &word : words)
+        word = static_cast<std::uint32_t>(rng());
+    const std::size_t top = (bits - 1) % 32;
+    words.back() &= static_cast<std::uint32_t>((std::uint64_t(2) << top) - 1);
+    words.back() |= std::uint32_t(1) << top;
+    return words;
+}
+
+boost::multiprecision::cpp_int ToCppInt(const Words &words)
+{
+    boost::multiprecision::cpp_int x;
+    if (!words.empty())
+        boost::multiprecision::import_bits(x, words.begin(), words.end(), 32, false);
+    return x;
+}
+
+Words FromCppInt(const boost::multiprecision::cpp_int &x)
+{
+    Words words;
+    boost::multiprecision::export_bits(x, std::back_inserter(words), 32, false);
+    Normalize(words);
+    return words;
+}
+
+// Операнды случая; для тестов простоты половина случаев — простые числа
+std::vector<Words> GenerateCase(Operation operation, std::size_t bits, std::uint64_t caseSeed)
+{
+    std::mt19937_64 rng(caseSeed);
+    switch (operation)
+    {
+    case Operation::Add:
+    case Operation::Mul:
+        return {RandomWords(rng, bits), RandomWords(rng, 1 + rng() % bits)};
+    case Operation::Sub:
+        return {RandomWords(rng, bits), RandomWords(rng, std::max<std::size_t>(1, bits - 1 - rng() % bits))};
+    case Operation::DivMod:
+        return {RandomWords(rng, bits), RandomWords(rng, std::max<std::size_t>(2, bits / 2 - rng() % (bits / 4)))};
+    case Operation::PowModOdd:
+    case Operation::PowModEven:
+    {
+        Words modulus = RandomWords(rng, bits);
+        if (operation == Operation::PowModOdd)
+            modulus[0] |= 1;
+        else
+            modulus[0] &= ~std::uint32_t(1);
+        return {RandomWords(rng, bits), RandomWords(rng, bits), modulus};
+    }
+    case Operation::Jacobi:
+    {
+        Words n = RandomWords(rng, bits);
+        n[0] |= 1;
+        return {RandomWords(rng, bits), n};
+    }
+    case Operation::MillerRabin:
+    case Operation::SoloveyStrassen:
+    {
+        Words n = RandomWords(rng, bits);
+        n[0] |= 1;
+        if (rng() % 2 == 0)
+            return {n};
+        boost::multiprecision::cpp_int x = ToCppInt(n);
+        while (!boost::multiprecision::miller_rabin_test(x, 25, rng))
+            x += 2;
+        return {FromCppInt(x)};
+    }
+    }
+    return {};
+}
+
+/// Бэкенд big_number::BasicBigNumber
+template <typename Limb> struct LegacyBackend
+{
+    using Number = big_number::BasicBigNumber<Limb>;
+    static constexpr const char *NAME = sizeof(Limb) == 8 ? "BigNumber" : "BigNumber32";
+
+    static Number Import(const Words &words)
+    {
+        constexpr std::size_t perLimb = sizeof(Limb) / sizeof(std::uint32_t);
+        const int length = std::max<int>(1, static_cast<int>((words.size() + perLimb - 1) / perLimb));
+        Number x(length);
+        x.SetLength(length);
+        Limb *limbs = x.GetCoefficients();
+        for (int i = 0; i < length; ++i)
+            limbs[i] = 0;
+        for (std::size_t i = 0; i < words.size(); ++i)
+            limbs[i / perLimb] |= static_cast<Limb>(words[i]) << (32 * (i % perLimb));
+        x.NormalizeLength();
+        return x;
+    }
+
+    static Words Export(Number x)
+    {
+        Words words;
+        const Limb *limbs = x.GetCoefficients();
+        for (int i = 0; i < x.GetLength(); ++i)
+        {
+            for (std::size_t j = 0; j < sizeof(Limb) / sizeof(std::uint32_t); ++j)
+                words.push_back(static_cast<std::uint32_t>(limbs[i] >> (32 * j)));
+        }
+        Normalize(words);
+        return words;
+    }
+
+    static void Run(Operation operation, const Number *in, Number *out)
+    {
+        switch (operation)
+        {
+        case Operation::Add:
+            out[0] = in[0] + in[1];
+            break;
+        case Operation::Sub:
+            out[0] = in[0] - in[1];
+            break;
+        case Operation::Mul:
+            out[0] = in[0] * in[1];
+            break;
+        case Operation::DivMod:
+            std::tie(out[0], out[1]) = in[0].DivMod(in[1]);
+            break;
+        case Operation::PowModOdd:
+        case Operation::PowModEven:
+            out[0] = in[0].ModularExponentiation(in[1], in[2]);
+            break;
+        case Operation::Jacobi:
+            out[0] = Number(static_cast<unsigned long long>(generic::Jacobi(in[0], in[1]) + 1));
+            break;
+        case Operation::MillerRabin:
+            out[0] = Number(static_cast<unsigned long long>(Number(in[0]).MillerRabinTest(PRIMALITY_ROUNDS)));
+            break;
+        case Operation::SoloveyStrassen:
+            out[0] = Number(static_cast<unsigned long long>(Number(in[0]).SoloveyStrassenTest(PRIMALITY_ROUNDS)));
+            break;
+        }
+    }
+};
+
+/// Бэкенд boost::multiprecision::cpp_int
+struct BoostBackend
+{
+    using Number = boost::multiprecision::cpp_int;
+    static constexpr const char *NAME = "cpp_int";
+
+    static Number Import(const Words &words)
+    {
+        return ToCppInt(words);
+    }
+
+    static Words Export(const Number &x)
+    {
+        return FromCppInt(x);
+    }
+
+    static void Run(Operation operation, const Number *in, Number *out)
+    {
+        switch (operation)
+        {
+        case Operation::Add:
+            out[0] = in[0] + in[1];
+            break;
+        case Operation::Sub:
+            out[0] = in[0] - in[1];
+            break;
+        case Operation::Mul:
+            out[0] = in[0] * in[1];
+            break;
+        case Operation::DivMod:
+            boost::multiprecision::divide_qr(in[0], in[1], out[0], out[1]);
+            break;
+        case Operation::PowModOdd:
+        case Operation::PowModEven:
+            out[0] = boost::multiprecision::powm(in[0], in[1], in[2]);
+            break;
+        case Operation::Jacobi:
+            out[0] = generic::Jacobi(in[0], in[1]) + 1;
+            break;
+        case Operation::MillerRabin:
+            out[0] = generic::MillerRabinTest(in[0], PRIMALITY_ROUNDS) ? 1 : 0;
+            break;
+        case Operation::SoloveyStrassen:
+            out[0] = generic::SoloveyStrassenTest(in[0], PRIMALITY_ROUNDS) ? 1 : 0;
+            break;
+        }
+    }
+};
+
+struct Measurement
+{
+    double seconds = 0;
+    std::vector<std::vector<Words>> outputs; ///< Результаты по случаям
+};
+
+// Операнды переводятся в бэкенд заранее, в замер входит только сама операция
+template <typename Backend>
+Measurement Measure(Operation operation, int inputs, const std::vector<std::vector<Words>> &cases)
+{
+    using Number = typename Backend::Number;
+    std::vector<std::vector<Number>> operands;
+    for (const std::vector<Words> &words : cases)
+    {
+        std::vector<Number> numbers;
+        for (int i = 0; i < inputs; ++i)
+            numbers.push_back(Backend::Import(words[i]));
+        operands.push_back(std::move(numbers));
+    }
+    std::vector<std::vector<Number>> results(cases.size(), std::vector<Number>(2));
+
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < cases.size(); ++i)
+        Backend::Run(operation, operands[i].data(), results[i].data());
+    const auto end = std::chrono::steady_clock::now();
+
+    Measurement measurement;
+    measurement.seconds = std::chrono::duration<double>(end - start).count();
+    for (const std::vector<Number> &result : results)
+        measurement.outputs.push_back({Backend::Export(result[0]), Backend::Export(result[1])});
+    return measurement;
+}
+
+std::string Hex(const Words &words)
+{
+    std::ostringstream out;
+    out << "0x" << std::hex << ToCppInt(words);
+    return out.str();
+}
+
+struct Options
+{
+    std::uint64_t seed = 1;
+    std::size_t count = 256;
+    std::string operation;
+    std::size_t bits = 0;
+    bool replay = false;
+    std::uint64_t caseSeed = 0;
+};
+
+Options ParseOptions(int argc, char **argv)
+{
+    Options options;
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        const std::string key = argv[i];
+        const char *value = argv[i + 1];
+        if (key == "--seed")
+            options.seed = std::strtoull(value, nullptr, 0);
+        else if (key == "--count")
+            options.count = std::strtoull(value, nullptr, 0);
+        else if (key == "--op")
+            options.operation = value;
+        else if (key == "--bits")
+            options.bits = std::strtoull(value, nullptr, 0);
+        else if (key == "--case-seed")
+        {
+            options.replay = true;
+            options.caseSeed = std::strtoull(value, nullptr, 0);
+        }
+        else
+            throw std::invalid_argument("Unknown option " + key);
+    }
+    if (options.replay && (options.operation.empty() || options.bits == 0))
+        throw std::invalid_argument("--case-seed requires --op and --bits.");
+    return options;
+}
+} // namespace
+
+int main(int argc, char **argv)
+{
+    Options options;
+    try
+    {
+        options = ParseOptions(argc, argv);
+    }
+    catch (const std::invalid_argument &error)
+    {
+        std::cerr << error.what() << "\n";
+        return 2;
+    }
+    std::cout << "seed " << options.seed << ", kernels " << big_number::kernels::Implementation() << "\n\n";
+    std::cout << std::left << std::setw(18) << "operation" << std::right << std::setw(7) << "bits" << std::setw(7)
+              << "cases" << std::setw(16) << std::string(LegacyBackend<std::uint64_t>::NAME) + "/s" << std::setw(16)
+              << std::string(LegacyBackend<std::uint32_t>::NAME) + "/s" << std::setw(16)
+              << std::string(BoostBackend::NAME) + "/s" << std::setw(12) << "BN:cpp_int" << "\n";
+
+    std::size_t mismatches = 0;
+    for (const OperationInfo &info : Operations())
+    {
+        if (!options.operation.empty() && options.operation != info.name)
+            continue;
+        const std::vector<std::size_t> sizes = options.bits != 0 ? std::vector<std::size_t>{options.bits} : info.bits;
+        for (std::size_t bits : sizes)
+        {
+            // Число случаев уменьшается с ростом стоимости операции, но не меньше 4
+            std::size_t count = options.count * 256 / (bits * info.workPerCase / 64 + 256);
+            count = options.replay ? 1 : std::max<std::size_t>(count, 4);
+            std::vector<std::uint64_t> seeds;
+            std::vector<std::vector<Words>> cases;
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                seeds.push_back(options.replay ? options.caseSeed : CaseSeed(options.seed, info.operation, bits, i));
+                cases.push_back(GenerateCase(info.operation, bits, seeds.back()));
+            }
+
+            const Measurement legacy = Measure<LegacyBackend<std::uint64_t>>(info.operation, info.inputs, cases);
+            const Measurement legacy32 = Measure<LegacyBackend<std::uint32_t>>(info.operation, info.inputs, cases);
+            const Measurement boost = Measure<BoostBackend>(info.operation, info.inputs, cases);
+
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                if (legacy.outputs[i] == boost.outputs[i] && legacy32.outputs[i] == boost.outputs[i])
+                    continue;
+                ++mismatches;
+                std::cout << "MISMATCH " << info.name << " bits " << bits << ": rerun with --op " << info.name
+                          << " --bits " << bits << " --case-seed 0x" << std::hex << seeds[i] << std::dec << "\n";
+                for (int k = 0; k < info.inputs; ++k)
+                    std::cout << "  input " << k << " = " << Hex(cases[i][k]) << "\n";
+                for (int k = 0; k < 2; ++k)
+                {
+                    std::cout << "  output " << k << ": BigNumber " << Hex(legacy.outputs[i][k]) << ", BigNumber32 "
+                              << Hex(legacy32.outputs[i][k]) << ", cpp_int " << Hex(boost.outputs[i][k]) << "\n";
+                }
+            }
+
+            const double n = static_cast<double>(count);
+            std::cout << std::left << std::setw(18) << info.name << std::right << std::setw(7) << bits << std::setw(7)
+                      << count << std::fixed << std::setprecision(0) << std::setw(16) << n / legacy.seconds
+                      << std::setw(16) << n / legacy32.seconds << std::setw(16) << n / boost.seconds
+                      << std::setprecision(2) << std::setw(12) << boost.seconds / legacy.seconds << "\n"
+                      << std::defaultfloat;
+        }
+    }
+
+    std::cout << "\n" << (mismatches == 0 ? "all backends agree" : "MISMATCHES: " + std::to_string(mismatches)) << "\n";
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,334 @@
+#ifndef GENERIC_ALGORITHMS_HPP
+#define GENERIC_ALGORITHMS_HPP
+
+#include "number_traits.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+/// @brief Теоретико-числовые алгоритмы, общие для всех бэкендов длинных чисел
+///
+/// Одна реализация возведения в степень по модулю, символа Якоби, тестов Ферма,
+/// Миллера-Рабина, Соловея-Штрассена, Люка и генерации простых чисел для любого
+/// типа, у которого есть специализация NumberTraits: boost::multiprecision::cpp_int,
+/// целые Boost фиксированной длины (uint256_t, ...) и big_number::BigNumber.
+/// Самый быстрый путь выбирается при компиляции через NumberTraits: для BigNumber
+/// повторные возведения в квадрат идут в форме Монтгомери, для Boost — через powm
+/// и произведение в типе двойной длины. Функции возвращают bool или числа,
+/// созданные вне временных областей, поэтому их можно вызывать в любом потоке.
+namespace generic
+{
+namespace detail
+{
+// Нечетные простые до 256 для отсева кандидатов перед тестом Миллера-Рабина
+constexpr std::uint32_t SMALL_PRIMES[] = {3,   5,   7,   11,  13,  17,  19,  23,  29,  31,  37,  41,  43,
+                                          47,  53,  59,  61,  67,  71,  73,  79,  83,  89,  97,  101, 103,
+                                          107, 109, 113, 127, 131, 137, 139, 149, 151, 157, 163, 167, 173,
+                                          179, 181, 191, 193, 197, 199, 211, 223, 227, 229, 233, 239, 241, 251};
+
+template <typename Number> void CheckPrimalityInput(const Number &n)
+{
+    if (n < NumberTraits<Number>::FromUInt(4))
+        throw std::invalid_argument("N must be grater then 3");
+}
+
+// Младшие bits бит числа (bits <= 8)
+template <typename Number> unsigned LowBits(const Number &x, unsigned bits)
+{
+    unsigned value = 0;
+    for (unsigned i = 0; i < bits; ++i)
+        value |= static_cast<unsigned>(NumberTraits<Number>::TestBit(x, i)) << i;
+    return value;
+}
+
+// Различные простые делители m пробным делением
+template <typename Number> std::vector<Number> PrimeDivisors(Number m)
+{
+    using Traits = NumberTraits<Number>;
+    const Number one = Traits::FromUInt(1);
+    const Number two = Traits::FromUInt(2);
+    std::vector<Number> divisors;
+    if (!Traits::TestBit(m, 0))
+    {
+        divisors.push_back(two);
+        m = m >> static_cast<int>(Traits::TrailingZeros(m));
+    }
+    Number quotient, remainder;
+    for (Number p = Traits::FromUInt(3); p * p <= m; p = p + two)
+    {
+        Traits::DivMod(m, p, quotient, remainder);
+        if (!(remainder == Traits::FromUInt(0)))
+            continue;
+        divisors.push_back(p);
+        do
+        {
+            m = quotient;
+            Traits::DivMod(m, p, quotient, remainder);
+        } while (remainder == Traits::FromUInt(0));
+    }
+    if (one < m)
+        divisors.push_back(m);
+    return divisors;
+}
+} // namespace detail
+
+/// @brief Возведение в степень по модулю
+/// @param[in] base Основание
+/// @param[in] exponent Неотрицательный показатель
+/// @param[in] modulus Положительный модуль
+/// @return base^exponent mod modulus
+template <typename Number>
+IfNumber<Number, Number> PowMod(const Number &base, const Number &exponent, const Number &modulus)
+{
+    using Traits = NumberTraits<Number>;
+    if (modulus == Traits::FromUInt(1))
+        return Traits::FromUInt(0);
+    return Traits::PowMod(base, exponent, modulus);
+}
+
+/// @brief Символ Якоби (a/n) двоичным алгоритмом без рекурсии
+/// @param[in] a Неотрицательное число
+/// @param[in] n Нечетный положительный модуль
+/// @return -1, 0 или 1
+/// @throw std::invalid_argument если n четно
+template <typename Number> IfNumber<Number, int> Jacobi(const Number &a, const Number &n)
+{
+    using Traits = NumberTraits<Number>;
+    if (!Traits::TestBit(n, 0))
+        throw std::invalid_argument("The Jacobi symbol requires an odd modulus.");
+
+    const Number zero = Traits::FromUInt(0);
+    Number x = a % n;
+    Number y = n;
+    int result = 1;
+    while (!(x == zero))
+    {
+        // (2/y) = -1 при y = 3, 5 (mod 8)
+        const std::size_t zeros = Traits::TrailingZeros(x);
+        x = x >> static_cast<int>(zeros);
+        const unsigned y8 = detail::LowBits(y, 3);
+        if ((zeros & 1) != 0 && (y8 == 3 || y8 == 5))
+            result = -result;
+        // Квадратичный закон взаимности
+        if (detail::LowBits(x, 2) == 3 && (y8 & 3) == 3)
+            result = -result;
+        std::swap(x, y);
+        x = x % y;
+    }
+    return y == Traits::FromUInt(1) ? result : 0;
+}
+
+#ifdef GENERIC_HAS_BIG_NUMBER
+/// @brief Символ Якоби (a/n) для чисел во внешних буферах
+///
+/// Алгоритм изменяет рабочие копии аргументов, поэтому они создаются во
+/// временной области арены потока, а сами буферы не копируются в кучу.
+/// @param[in] a Неотрицательное число
+/// @param[in] n Нечетный положительный модуль
+/// @return -1, 0 или 1
+/// @throw std::invalid_argument если n четно
+template <typename Limb>
+int Jacobi(const big_number::BasicBigNumberView<Limb> &a, const big_number::BasicBigNumberView<Limb> &n)
+{
+    if (!n.IsOdd())
+        throw std::invalid_argument("The Jacobi symbol requires an odd modulus.");
+    [[maybe_unused]] typename NumberTraits<big_number::BasicBigNumber<Limb>>::Scope scope;
+    return Jacobi(a.ToNumber(), n.ToNumber());
+}
+#endif
+
+/// @brief Тест Ферма
+/// @param[in] n Проверяемое число больше 3
+/// @param[in] rounds Число случайных оснований
+/// @return true, если n вероятно простое
+/// @throw std::invalid_argument если n < 4
+template <typename Number> IfNumber<Number, bool> FermatTest(const Number &n, std::size_t rounds)
+{
+    using Traits = NumberTraits<Number>;
+    detail::CheckPrimalityInput(n);
+    if (!Traits::TestBit(n, 0))
+        return false;
+
+    // Временные числа теста живут в области бэкенда; каждый раунд откатывает ее к началу
+    [[maybe_unused]] typename Traits::Scope scope;
+    const Number one = Traits::FromUInt(1);
+    const Number nMinusOne = n - one;
+    const Number nMinusTwo = n - Traits::FromUInt(2);
+    const typename Traits::OddModulus modulus(n);
+    for (std::size_t i = 0; i < rounds; ++i)
+    {
+        [[maybe_unused]] typename Traits::Scope round;
+        if (!(modulus.PowMod(Traits::Random(Traits::FromUInt(2), nMinusTwo), nMinusOne) == one))
+            return false;
+    }
+    return true;
+}
+
+/// @brief Тест Миллера-Рабина
+///
+/// Возведения в квадрат одного раунда выполняются в контексте OddModulus
+/// (для BigNumber — в форме Монтгомери без перевода обратно).
+/// @param[in] n Проверяемое число больше 3
+/// @param[in] rounds Число случайных оснований
+/// @return true, если n вероятно простое
+/// @throw std::invalid_argument если n < 4
+template <typename Number> IfNumber<Number, bool> MillerRabinTest(const Number &n, std::size_t rounds)
+{
+    using Traits = NumberTraits<Number>;
+    detail::CheckPrimalityInput(n);
+    if (!Traits::TestBit(n, 0))
+        return false;
+
+    [[maybe_unused]] typename Traits::Scope scope;
+    // n - 1 = 2^s * r, r нечетное
+    const Number one = Traits::FromUInt(1);
+    const Number nMinusOne = n - one;
+    const Number nMinusTwo = n - Traits::FromUInt(2);
+    const std::size_t s = Traits::TrailingZeros(nMinusOne);
+    const Number r = nMinusOne >> static_cast<int>(s);
+
+    const typename Traits::OddModulus modulus(n);
+    const Number oneInContext = modulus.Enter(one);
+    const Number nMinusOneInContext = modulus.Enter(nMinusOne);
+    for (std::size_t i = 0; i < rounds; ++i)
+    {
+        [[maybe_unused]] typename Traits::Scope round;
+        const Number y = modulus.PowMod(Traits::Random(Traits::FromUInt(2), nMinusTwo), r);
+        if (y == one || y == nMinusOne)
+            continue;
+
+        Number z = modulus.Enter(y);
+        std::size_t j = 1;
+        for (; j < s; ++j)
+        {
+            modulus.Square(z);
+            if (z == nMinusOneInContext)
+                break;
+            if (z == oneInContext)
+                return false;
+        }
+        if (j == s)
+            return false;
+    }
+    return true;
+}
+
+/// @brief Тест Соловея-Штрассена
+/// @param[in] n Проверяемое число больше 3
+/// @param[in] rounds Число случайных оснований
+/// @return true, если n вероятно простое
+/// @throw std::invalid_argument если n < 4
+template <typename Number> IfNumber<Number, bool> SoloveyStrassenTest(const Number &n, std::size_t rounds)
+{
+    using Traits = NumberTraits<Number>;
+    detail::CheckPrimalityInput(n);
+    if (!Traits::TestBit(n, 0))
+        return false;
+
+    [[maybe_unused]] typename Traits::Scope scope;
+    const Number one = Traits::FromUInt(1);
+    const Number nMinusOne = n - one;
+    const Number nMinusTwo = n - Traits::FromUInt(2);
+    const Number halfOrder = nMinusOne >> 1;
+    const typename Traits::OddModulus modulus(n);
+    for (std::size_t i = 0; i < rounds; ++i)
+    {
+        [[maybe_unused]] typename Traits::Scope round;
+        const Number a = Traits::Random(Traits::FromUInt(2), nMinusTwo);
+        const Number r = modulus.PowMod(a, halfOrder);
+        // a^((n-1)/2) должно совпасть с (a/n) по модулю n
+        const int jacobi = Jacobi(a, n);
+        if (!((jacobi == 1 && r == one) || (jacobi == -1 && r == nMinusOne)))
+            return false;
+    }
+    return true;
+}
+
+/// @brief Тест Люка: n простое, если для некоторого a выполнено a^(n-1) = 1 и
+/// a^((n-1)/p) != 1 (mod n) для всех простых p | n-1
+///
+/// n - 1 раскладывается пробным делением, поэтому тест применим только к числам,
+/// у которых n - 1 раскладывается на небольшие множители.
+/// @param[in] n Нечетное число больше 3
+/// @param[in] rounds Число случайных оснований
+/// @return true, если простота доказана; false, если n составное или основание не найдено
+/// @throw std::invalid_argument если n < 4 или четно
+template <typename Number> IfNumber<Number, bool> LucasTest(const Number &n, std::size_t rounds)
+{
+    using Traits = NumberTraits<Number>;
+    detail::CheckPrimalityInput(n);
+    if (!Traits::TestBit(n, 0))
+        throw std::invalid_argument("N must be odd");
+
+    [[maybe_unused]] typename Traits::Scope scope;
+    const Number one = Traits::FromUInt(1);
+    const Number nMinusOne = n - one;
+    const Number nMinusTwo = n - Traits::FromUInt(2);
+    const std::vector<Number> divisors = detail::PrimeDivisors(nMinusOne);
+    const typename Traits::OddModulus modulus(n);
+    for (std::size_t i = 0; i < rounds; ++i)
+    {
+        [[maybe_unused]] typename Traits::Scope round;
+        const Number a = Traits::Random(Traits::FromUInt(2), nMinusTwo);
+        if (!(modulus.PowMod(a, nMinusOne) == one))
+            return false;
+
+        bool generator = true;
+        for (const Number &p : divisors)
+        {
+            if (modulus.PowMod(a, nMinusOne / p) == one)
+            {
+                generator = false;
+                break;
+            }
+        }
+        if (generator)
+            return true;
+    }
+    return false;
+}
+
+/// @brief Случайное вероятно простое число ровно из bits бит
+///
+/// Кандидаты с малыми делителями отсеиваются остатками от деления на
+/// коэффициент до запуска теста Миллера-Рабина.
+/// @param[in] bits Длина в битах, не меньше 2
+/// @param[in] rounds Раундов теста Миллера-Рабина
+/// @throw std::invalid_argument если bits < 2
+template <typename Number> IfNumber<Number, Number> GenerateRandomPrime(std::size_t bits, std::size_t rounds = 25)
+{
+    using Traits = NumberTraits<Number>;
+    if (bits < 2)
+        throw std::invalid_argument("bitLength must be at least 2");
+
+    const Number one = Traits::FromUInt(1);
+    const Number low = one << static_cast<int>(bits - 1);
+    const Number high = (one << static_cast<int>(bits)) - one;
+    while (true)
+    {
+        Number candidate = Traits::Random(low, high);
+        if (!Traits::TestBit(candidate, 0))
+            candidate = candidate + one;
+
+        bool sieved = false;
+        for (std::uint32_t p : detail::SMALL_PRIMES)
+        {
+            if (Traits::ModSmall(candidate, p) == 0)
+            {
+                sieved = !(candidate == Traits::FromUInt(p));
+                break;
+            }
+        }
+        if (sieved)
+            continue;
+        if (candidate < Traits::FromUInt(4) || MillerRabinTest(candidate, rounds))
+            return candidate;
+    }
+}
+
+} // namespace generic
+
+#endif // GENERIC_ALGORITHMS_HPP
@@ -0,0 +1,250 @@
+#ifndef NUMBER_TRAITS_HPP
+#define NUMBER_TRAITS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+
+#if __has_include("big_number.hpp")
+#include "arena.hpp"
+#include "big_number.hpp"
+#include "big_number_view.hpp"
+#include "montgomery.hpp"
+#define GENERIC_HAS_BIG_NUMBER 1
+#endif
+
+#if __has_include(<boost/multiprecision/cpp_int.hpp>)
+#include <boost/multiprecision/cpp_int.hpp>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int_distribution.hpp>
+#include <random>
+#define GENERIC_HAS_BOOST 1
+#endif
+
+namespace generic
+{
+/// @brief Операции над длинными числами, через которые работают обобщенные алгоритмы
+///
+/// Специализация для типа Number задает SUPPORTED = true и предоставляет:
+/// - Scope — область временной памяти на один раунд алгоритма;
+/// - OddModulus — контекст повторных умножений по нечетному модулю
+///   (PowMod в обычной форме, Enter — перевод в форму контекста, Square — квадрат на месте);
+/// - FromUInt, BitLength, TestBit, TrailingZeros, ModSmall, DivMod, MulMod, PowMod, Random.
+/// Сложение, вычитание, сравнение и сдвиги выполняются операторами самого типа.
+/// Каждая операция отображается на самую быструю реализацию бэкенда.
+template <typename Number, typename = void> struct NumberTraits
+{
+    static constexpr bool SUPPORTED = false;
+};
+
+/// Тип R, если для Number есть специализация NumberTraits
+template <typename Number, typename R> using IfNumber = std::enable_if_t<NumberTraits<Number>::SUPPORTED, R>;
+
+/// @brief Область без действий для бэкендов без собственной временной памяти
+struct NoScope
+{
+};
+
+/// @brief Контекст по нечетному модулю на обычных вычетах: каждое умножение завершается MulMod
+template <typename Number> class ResidueModulus
+{
+  public:
+    explicit ResidueModulus(const Number &modulus) : modulus_(modulus)
+    {
+    }
+
+    Number PowMod(const Number &base, const Number &exponent) const
+    {
+        return NumberTraits<Number>::PowMod(base, exponent, modulus_);
+    }
+
+    Number Enter(const Number &x) const
+    {
+        return x;
+    }
+
+    void Square(Number &x) const
+    {
+        x = NumberTraits<Number>::MulMod(x, x, modulus_);
+    }
+
+  private:
+    Number modulus_;
+};
+
+#ifdef GENERIC_HAS_BIG_NUMBER
+/// @brief big_number::BasicBigNumber: арена потока, Монтгомери, деление Кнута и окно Барретта
+template <typename Limb> struct NumberTraits<big_number::BasicBigNumber<Limb>>
+{
+    using Number = big_number::BasicBigNumber<Limb>;
+    using Scope = big_number::ArenaScope;
+
+    static constexpr bool SUPPORTED = true;
+
+    /// @brief Контекст Монтгомери; числа внутри контекста хранятся в форме Монтгомери
+    class OddModulus
+    {
+      public:
+        explicit OddModulus(const Number &modulus) : montgomery_(modulus)
+        {
+        }
+
+        Number PowMod(const Number &base, const Number &exponent) const
+        {
+            return montgomery_.PowMod(base, exponent);
+        }
+
+        Number Enter(const Number &x) const
+        {
+            return montgomery_.ToMontgomery(x);
+        }
+
+        void Square(Number &x) const
+        {
+            montgomery_.SquareInPlace(x);
+        }
+
+      private:
+        big_number::BasicMontgomeryContext<Limb> montgomery_;
+    };
+
+    static Number FromUInt(unsigned long long value)
+    {
+        return Number(value);
+    }
+
+    static std::size_t BitLength(const Number &x)
+    {
+        return static_cast<std::size_t>(x.BitLength());
+    }
+
+    static bool TestBit(const Number &x, std::size_t index)
+    {
+        return x.TestBit(static_cast<int>(index));
+    }
+
+    static std::size_t TrailingZeros(const Number &x)
+    {
+        return static_cast<std::size_t>(x.CountTrailingZeros());
+    }
+
+    static unsigned long long ModSmall(const Number &x, std::uint32_t divisor)
+    {
+        Number remainder = x % static_cast<typename Number::BaseType>(divisor);
+        return remainder.GetCoefficients()[0];
+    }
+
+    static void DivMod(const Number &a, const Number &b, Number &quotient, Number &remainder)
+    {
+        std::tie(quotient, remainder) = a.DivMod(b);
+    }
+
+    static Number MulMod(const Number &a, const Number &b, const Number &modulus)
+    {
+        return a * b % modulus;
+    }
+
+    static Number PowMod(const Number &base, const Number &exponent, const Number &modulus)
+    {
+        return base.ModularExponentiation(exponent, modulus);
+    }
+
+    static Number Random(const Number &low, const Number &high)
+    {
+        return Number::Generator(0, low, high);
+    }
+};
+#endif
+
+#ifdef GENERIC_HAS_BOOST
+/// @brief boost::multiprecision::number<cpp_int_backend<...>>: произвольной и фиксированной длины
+///
+/// Возведение в степень — boost::multiprecision::powm. Для типов фиксированной
+/// длины произведение по модулю считается в типе двойной длины, чтобы не терять
+/// старшую половину. Если аллокатор задает тип Scope (как ArenaAllocator
+/// boosted_algorithms), он используется как область временной памяти.
+template <unsigned MinBits, unsigned MaxBits, boost::multiprecision::cpp_integer_type SignType,
+          boost::multiprecision::cpp_int_check_type Checked, typename Allocator,
+          boost::multiprecision::expression_template_option ExpressionTemplates>
+struct NumberTraits<boost::multiprecision::number<
+    boost::multiprecision::cpp_int_backend<MinBits, MaxBits, SignType, Checked, Allocator>, ExpressionTemplates>>
+{
+    using Number = boost::multiprecision::number<
+        boost::multiprecision::cpp_int_backend<MinBits, MaxBits, SignType, Checked, Allocator>, ExpressionTemplates>;
+
+    static constexpr bool SUPPORTED = true;
+    static constexpr bool FIXED_WIDTH = MaxBits != 0 && std::is_void<Allocator>::value;
+
+    template <typename A, typename = void> struct AllocatorScope
+    {
+        using Type = NoScope;
+    };
+    template <typename A> struct AllocatorScope<A, std::void_t<typename A::Scope>>
+    {
+        using Type = typename A::Scope;
+    };
+    using Scope = typename AllocatorScope<Allocator>::Type;
+    using OddModulus = ResidueModulus<Number>;
+
+    // Тип, в котором помещается произведение двух вычетов
+    using Wide = std::conditional_t<FIXED_WIDTH,
+                                    boost::multiprecision::number<boost::multiprecision::cpp_int_backend<
+                                        2 * MaxBits, 2 * MaxBits, SignType, Checked, void>>,
+                                    Number>;
+
+    static Number FromUInt(unsigned long long value)
+    {
+        return Number(value);
+    }
+
+    static std::size_t BitLength(const Number &x)
+    {
+        return x == 0 ? 0 : static_cast<std::size_t>(boost::multiprecision::msb(x)) + 1;
+    }
+
+    static bool TestBit(const Number &x, std::size_t index)
+    {
+        return boost::multiprecision::bit_test(x, static_cast<unsigned>(index));
+    }
+
+    static std::size_t TrailingZeros(const Number &x)
+    {
+        return static_cast<std::size_t>(boost::multiprecision::lsb(x));
+    }
+
+    static unsigned long long ModSmall(const Number &x, std::uint32_t divisor)
+    {
+        return static_cast<unsigned long long>(x % divisor);
+    }
+
+    static void DivMod(const Number &a, const Number &b, Number &quotient, Number &remainder)
+    {
+        boost::multiprecision::divide_qr(a, b, quotient, remainder);
+    }
+
+    static Number MulMod(const Number &a, const Number &b, const Number &modulus)
+    {
+        if constexpr (FIXED_WIDTH)
+            return static_cast<Number>(Wide(a) * Wide(b) % Wide(modulus));
+        else
+            return a * b % modulus;
+    }
+
+    static Number PowMod(const Number &base, const Number &exponent, const Number &modulus)
+    {
+        return boost::multiprecision::powm(base, exponent, modulus);
+    }
+
+    static Number Random(const Number &low, const Number &high)
+    {
+        // Генератор свой у каждого потока: параллельные тесты простоты не делят состояние
+        static thread_local boost::random::mt19937_64 engine(std::random_device{}());
+        return boost::random::uniform_int_distribution<Number>(low, high)(engine);
+    }
+};
+#endif
+
+} // namespace generic
+
+#endif // NUMBER_TRAITS_HPP
@@ -1,16 +1,27 @@
+#include "arena.hpp"
+#include "barrett.hpp"
 #include "big_number.hpp"
+#include "big_number_view.hpp"
+#include "divisor.hpp"
+#include "generic_algorithms.hpp"
+#include "limb_kernels.hpp"
+#include "montgomery.hpp"
+#include "random.hpp"
 #include <cassert>
 #include <chrono>
 #include <iostream>
 #include <sstream>
+#include <vector>
 
 using namespace big_number;
+using namespace big_number::literals;
 namespace ErrorProb
 {
 BigNumber Pow(const BigNumber &number, const BigNumber &exp)
 {
-    BigNumber result("1");
-    for (big_number::BigNumber i("0"); i < exp; i += BigNumber("1"))
+    const BigNumber one = 1_bn;
+    BigNumber result = one;
+    for (BigNumber i; i < exp; i += one)
     {
         result = result * number;
     }
@@ -19,8 +30,7 @@ BigNumber Pow(const BigNumber &number, const BigNumber &exp)
 // Вспомогательная функция: φ(n)
 BigNumber GCD(BigNumber a, BigNumber b)
 {
-    BigNumber zero("0");
-    while (b != zero)
+    while (!b.IsZero())
     {
         BigNumber temp(b);
         b = a % b;
@@ -31,14 +41,14 @@ BigNumber GCD(BigNumber a, BigNumber b)
 
 BigNumber EulerTotient(const BigNumber &n)
 {
-    BigNumber count("0");
-    BigNumber one("1");
+    BigNumber count;
+    const BigNumber one = 1_bn;
 
-    for (BigNumber i = one; i < n; i = i + one)
+    for (BigNumber i = one; i < n; i += one)
     {
-        if (GCD(i, n) == one)
+        if (GCD(i, n).IsOne())
         {
-            count = count + one;
+            count += one;
         }
     }
 
@@ -47,22 +57,22 @@ BigNumber EulerTotient(const BigNumber &n)
 
 std::pair<BigNumber, BigNumber> Fermat(const BigNumber &n, size_t reliabilityParameter)
 {
-    BigNumber phi = Pow(EulerTotient(n), BigNumber(std::to_string(reliabilityParameter)));
-    BigNumber den = Pow(n, BigNumber(std::to_string(reliabilityParameter)));
+    BigNumber phi = Pow(EulerTotient(n), BigNumber(static_cast<unsigned long long>(reliabilityParameter)));
+    BigNumber den = Pow(n, BigNumber(static_cast<unsigned long long>(reliabilityParameter)));
     return {phi, den};
 }
 
 std::pair<BigNumber, BigNumber> MillerRabin(const BigNumber &n, size_t reliabilityParameter)
 {
-    BigNumber phi = Pow(EulerTotient(n), BigNumber(std::to_string(reliabilityParameter)));
-    BigNumber den = Pow((n * BigNumber("2")), BigNumber(std::to_string(reliabilityParameter)));
+    BigNumber phi = Pow(EulerTotient(n), BigNumber(static_cast<unsigned long long>(reliabilityParameter)));
+    BigNumber den = Pow(n * 2, BigNumber(static_cast<unsigned long long>(reliabilityParameter)));
     return {phi, den};
 }
 
 std::pair<BigNumber, BigNumber> SoloveyStrassen(const BigNumber &n, size_t reliabilityParameter)
 {
-    BigNumber phi = Pow(EulerTotient(n), BigNumber(std::to_string(reliabilityParameter)));
-    BigNumber den = Pow((n * BigNumber("4")), BigNumber(std::to_string(reliabilityParameter)));
+    BigNumber phi = Pow(EulerTotient(n), BigNumber(static_cast<unsigned long long>(reliabilityParameter)));
+    BigNumber den = Pow(n * 4, BigNumber(static_cast<unsigned long long>(reliabilityParameter)));
     return {phi, den};
 }
 
@@ -192,6 +202,729 @@ void TestEdgeCases()
     std::cout << "[+] TestEdgeCases PASSED\n";
 }
 
+void TestLimbWidths()
+{
+    // Одинаковые вычисления с 32- и 64-битными коэффициентами дают одинаковый десятичный результат
+    std::string a = "340282366920938463463374607431768211457";
+    std::string b = "18446744073709551629";
+
+    BigNumber a64(a), b64(b);
+    BigNumber32 a32(a), b32(b);
+
+    std::ostringstream out64, out32;
+    out64 << a64 * b64 << " " << a64 / b64 << " " << a64 % b64 << " " << a64 - b64;
+    out32 << a32 * b32 << " " << a32 / b32 << " " << a32 % b32 << " " << a32 - b32;
+    assert(out64.str() == out32.str());
+    assert(toString(a64 * b64) == "6277101735386680768259460193179866441144672085150730813453");
+
+    std::cout << "[+] TestLimbWidths PASSED\n";
+}
+
+void TestInPlaceOperations()
+{
+    BigNumber a = fromString("18446744073709551615");
+    a += a; // сложение с самим собой
+    assert(toString(a) == "36893488147419103230");
+
+    a -= fromString("36893488147419103229");
+    assert(toString(a) == "1");
+
+    BigNumber b = fromString("18446744073709551615");
+    b *= static_cast<BigNumber::BaseType>(16);
+    assert(toString(b) == "295147905179352825840");
+
+    BigNumber moved(std::move(b));
+    assert(toString(moved) == "295147905179352825840");
+    assert(toString(b) == "0");
+
+    b = std::move(moved);
+    assert(toString(b) == "295147905179352825840");
+    assert(toString(moved) == "0");
+
+    std::cout << "[+] TestInPlaceOperations PASSED\n";
+}
+
+void TestLargeMultiplication()
+{
+    // (10^n - 1)^2 = 99...9800...01; длины выбраны так, чтобы задействовать Карацубу и Тоом-3
+    for (int n : {700, 3000, 9000})
+    {
+        BigNumber nines(std::string(n, '9'));
+        std::string expected = std::string(n - 1, '9') + "8" + std::string(n - 1, '0') + "1";
+        assert(toString(nines * nines) == expected);
+
+        // Несимметричное умножение: длинный сомножитель режется на куски
+        BigNumber shortNines(std::string(n / 3, '9'));
+        assert(nines * shortNines == shortNines * nines);
+        assert((nines * shortNines) / shortNines == nines);
+    }
+
+    std::cout << "[+] TestLargeMultiplication PASSED\n";
+}
+
+void TestNttMultiplication()
+{
+    // Повторное возведение в квадрат до длины, на которой включается NTT
+    BigNumber x = fromString("98765432109876543210987654321");
+    while (x.GetLength() < 2500)
+        x = x * x;
+    BigNumber copy = x;
+    BigNumber y = x + BigNumber("1");
+
+    assert(x * x == x * copy); // возведение в квадрат с одним прямым преобразованием
+    BigNumber product = x * y;
+    assert(product / y == x);
+    assert(product % x == BigNumber("0"));
+
+    std::cout << "[+] TestNttMultiplication PASSED\n";
+}
+
+void TestFastSquare()
+{
+    // Старшие коэффициенты из одних единиц проверяют переносы при удвоении
+    assert(toString(fromString("18446744073709551615").FastSquare()) == "340282366920938463426481119284349108225");
+    assert(fromString("0").FastSquare() == fromString("0"));
+
+    // Длины ниже и выше порогов Карацубы и Тоома-3
+    for (int digits : {30, 400, 2000, 6000})
+    {
+        BigNumber x(std::string(digits, '7'));
+        BigNumber copy = x;
+        assert(x.FastSquare() == x * copy);
+
+        BigNumber32 x32(std::string(digits, '7'));
+        std::ostringstream out32;
+        out32 << x32.FastSquare();
+        assert(toString(x.FastSquare()) == out32.str());
+    }
+
+    std::cout << "[+] TestFastSquare PASSED\n";
+}
+
+// Вспомогательная функция: проверяет, что вызов f бросает std::invalid_argument
+template <typename F> void AssertThrowsInvalidArgument(F f)
+{
+    bool thrown = false;
+    try
+    {
+        f();
+    }
+    catch (const std::invalid_argument &)
+    {
+        thrown = true;
+    }
+    assert(thrown);
+}
+
+void TestBarrettContext()
+{
+    // 2^127 - 1 — простое Мерсенна
+    BigNumber m = fromString("170141183460469231731687303715884105727");
+    BarrettContext barrett(m);
+    assert(barrett.Modulus() == m);
+
+    BigNumber a = fromString("123456789012345678901234567890123456789");
+    BigNumber b = fromString("98765432109876543210987654321098765432");
+    assert(barrett.Multiply(a, b) == (a * b) % m);
+    assert(barrett.Square(a) == (a * a) % m);
+    assert(barrett.Reduce(m) == fromString("0"));
+    assert(barrett.Reduce(m - fromString("1")) == m - fromString("1"));
+
+    // Длинные числа и выход за пределы b^(2k) (обычное деление)
+    BigNumber longModulus(std::string(900, '3') + "1");
+    BarrettContext longBarrett(longModulus);
+    BigNumber x(std::string(1700, '8'));
+    assert(longBarrett.Reduce(x) == x % longModulus);
+    BigNumber huge = x * x;
+    assert(longBarrett.Reduce(huge) == huge % longModulus);
+
+    AssertThrowsInvalidArgument([&] { BarrettContext zero(fromString("0")); });
+
+    std::cout << "[+] TestBarrettContext PASSED\n";
+}
+
+void TestMontgomeryContext()
+{
+    BigNumber m = fromString("170141183460469231731687303715884105727"); // 2^127 - 1
+    MontgomeryContext montgomery(m);
+
+    BigNumber a = fromString("123456789012345678901234567890123456789");
+    BigNumber b = fromString("98765432109876543210987654321098765432");
+    BigNumber product = montgomery.Multiply(montgomery.ToMontgomery(a), montgomery.ToMontgomery(b));
+    assert(montgomery.FromMontgomery(product) == (a * b) % m);
+
+    BigNumber square = montgomery.ToMontgomery(a);
+    montgomery.SquareInPlace(square);
+    assert(montgomery.FromMontgomery(square) == (a * a) % m);
+
+    // Малая теорема Ферма и обычные степени
+    assert(montgomery.PowMod(fromString("3"), m - fromString("1")) == fromString("1"));
+    assert(MontgomeryContext(fromString("99991")).PowMod(fromString("12345"), fromString("1000")) ==
+           fromString("48599"));
+    assert(montgomery.PowMod(a, fromString("0")) == fromString("1"));
+
+    // Тест Миллера-Рабина на основе контекста Монтгомери
+    assert(m.MillerRabinTest(10));
+    assert(!fromString("170141183460469231731687303715884105729").MillerRabinTest(10)); // 2^127 + 1
+    assert(!fromString("561").MillerRabinTest(10));                                    // число Кармайкла
+
+    AssertThrowsInvalidArgument([&] { MontgomeryContext even(fromString("1000")); });
+
+    std::cout << "[+] TestMontgomeryContext PASSED\n";
+}
+
+void TestModularExponentiation()
+{
+    // Эталон: бинарное возведение справа налево с делением на каждом шаге
+    auto reference = [](BigNumber base, BigNumber exponent, const BigNumber &m) {
+        BigNumber result = fromString("1") % m;
+        base = base % m;
+        while (exponent != fromString("0"))
+        {
+            if (exponent % fromString("2") == fromString("1"))
+                result = (result * base) % m;
+            base = (base * base) % m;
+            exponent = exponent / fromString("2");
+        }
+        return result;
+    };
+
+    BigNumber base = fromString("123456789012345678901234567890123456789");
+    BigNumber exponent(std::string(200, '7'));
+    BigNumber oddModulus(std::string(150, '9') + "1");
+    BigNumber evenModulus(std::string(150, '9') + "8");
+    assert(base.ModularExponentiation(exponent, oddModulus) == reference(base, exponent, oddModulus));
+    assert(base.ModularExponentiation(exponent, evenModulus) == reference(base, exponent, evenModulus));
+    assert(fromString("3").ModularExponentiation(fromString("1000"), fromString("1024")) ==
+           reference(fromString("3"), fromString("1000"), fromString("1024")));
+
+    // Граничные случаи: нулевой показатель, модуль 1, основание больше модуля
+    assert(base.ModularExponentiation(fromString("0"), oddModulus) == fromString("1"));
+    assert(base.ModularExponentiation(fromString("0"), evenModulus) == fromString("1"));
+    assert(base.ModularExponentiation(exponent, fromString("1")) == fromString("0"));
+    assert(fromString("0").ModularExponentiation(exponent, evenModulus) == fromString("0"));
+    assert(fromString("17").ModularExponentiation(fromString("5"), fromString("10")) == fromString("7"));
+
+    AssertThrowsInvalidArgument([&] { base.ModularExponentiation(exponent, fromString("0")); });
+
+    // Вероятностные тесты работают через то же возведение в степень
+    BigNumber prime = fromString("170141183460469231731687303715884105727"); // 2^127 - 1
+    assert(prime.FermatTest(5));
+    assert(prime.SoloveyStrassenTest(5));
+    assert(!fromString("170141183460469231731687303715884105729").FermatTest(5));
+    assert(!fromString("170141183460469231731687303715884105729").SoloveyStrassenTest(5));
+
+    std::cout << "[+] TestModularExponentiation PASSED\n";
+}
+
+void TestBitOperations()
+{
+    BigNumber a = fromString("340282366920938463463374607431768211455"); // 2^128 - 1
+    BigNumber b = fromString("12345678901234567890");
+    BigNumber two64 = fromString("18446744073709551616");
+
+    // Сдвиги эквивалентны умножению и делению на степени двойки
+    assert((b << 0) == b);
+    assert((b << 64) == b * two64);
+    assert((b << 7) == b * fromString("128"));
+    assert(((b << 131) >> 131) == b);
+    assert((a >> 64) == fromString("18446744073709551615"));
+    assert((a >> 127) == fromString("1"));
+    assert((a >> 128) == fromString("0"));
+    assert((a >> 1000) == fromString("0"));
+    assert((fromString("0") << 100) == fromString("0"));
+    BigNumber c = b;
+    c <<= 70;
+    c >>= 70;
+    assert(c == b);
+
+    // Битовый доступ
+    assert(a.BitLength() == 128);
+    assert(two64.BitLength() == 65);
+    assert(fromString("0").BitLength() == 0);
+    assert(fromString("1").BitLength() == 1);
+    assert(two64.TestBit(64) && !two64.TestBit(63) && !two64.TestBit(1000));
+    assert(two64.CountTrailingZeros() == 64);
+    assert(fromString("96").CountTrailingZeros() == 5);
+    assert(fromString("0").CountTrailingZeros() == 0);
+    std::vector<bool> bits = fromString("6").ToBinary();
+    assert(bits.size() == 3 && bits[0] && bits[1] && !bits[2]);
+    assert(fromString("0").ToBinary().empty());
+
+    // Побитовые операции
+    assert((a & b) == b);
+    assert((a | b) == a);
+    assert((a ^ a) == fromString("0"));
+    assert((a ^ b) == a - b);
+    assert((two64 & b) == fromString("0"));
+    assert((two64 | fromString("1")) == two64 + fromString("1"));
+    BigNumber d = b;
+    d |= two64;
+    d ^= two64;
+    d &= a;
+    assert(d == b);
+
+    AssertThrowsInvalidArgument([&] { b << -1; });
+
+    // Алгоритмы, перешедшие на битовые операции
+    assert(fromString("3").DichatomicExponentiation(fromString("40")) == fromString("12157665459056928801"));
+    assert(fromString("1105").MillerRabinTest(10) == false); // число Кармайкла
+    assert(fromString("1000000007").SoloveyStrassenTest(10));
+
+    std::cout << "[+] TestBitOperations PASSED\n";
+}
+
+void TestDecimalConversion()
+{
+    auto toString = [](const auto &number) {
+        std::ostringstream out;
+        out << number;
+        return out.str();
+    };
+
+    // Длинные числа переводятся рекурсивно; результат сверяется со степенями десяти
+    const std::string ones = "1" + std::string(5000, '0');
+    const std::string nines(5000, '9');
+    BigNumber power = BigNumber(10ULL).DichatomicExponentiation(BigNumber(5000ULL));
+    assert(BigNumber(ones) == power);
+    assert(BigNumber(nines) == power - BigNumber(1ULL));
+    assert(toString(power) == ones);
+    assert(toString(power - BigNumber(1ULL)) == nines);
+
+    BigNumber32 power32 = BigNumber32(10ULL).DichatomicExponentiation(BigNumber32(3000ULL));
+    assert(toString(power32) == "1" + std::string(3000, '0'));
+    assert(BigNumber32("1" + std::string(3000, '0')) == power32);
+
+    // Нули внутри числа не теряются на границах блоков
+    std::string mixed;
+    for (int i = 0; i < 400; ++i)
+        mixed += (i % 7 == 0) ? "10000000000000000000000000000000000000" : "31415926535897932384";
+    assert(toString(BigNumber(mixed)) == mixed);
+    assert(toString(BigNumber32(mixed)) == mixed);
+
+    // Ведущие нули и ноль
+    assert(toString(BigNumber("000123")) == "123");
+    assert(toString(BigNumber("0000")) == "0");
+    assert(toString(BigNumber()) == "0");
+
+    AssertThrowsInvalidArgument([&] { BigNumber invalid("12a4"); });
+
+    std::cout << "[+] TestDecimalConversion PASSED\n";
+}
+
+void TestDivMod()
+{
+    BigNumber a = fromString("123456789012345678901234567890123456789012345678901234567890");
+    BigNumber b = fromString("98765432109876543210987");
+
+    auto [quotient, remainder] = a.DivMod(b);
+    assert(quotient * b + remainder == a);
+    assert(remainder < b);
+    assert(quotient == a / b && remainder == a % b);
+
+    // Повторные деления на один делитель через общую рабочую память
+    DivisionWorkspace workspace;
+    BigNumber q, r;
+    BigNumber x = a;
+    for (int i = 0; i < 10; ++i)
+    {
+        x.DivMod(b, q, r, workspace);
+        assert(q * b + r == x);
+        assert(r < b);
+        x = x * fromString("1000003") + fromString("17");
+    }
+
+    // Смена делителя сбрасывает кэш нормализованного делителя
+    BigNumber c = fromString("340282366920938463463374607431768211457"); // 2^128 + 1
+    a.DivMod(c, q, r, workspace);
+    assert(q == a / c && r == a % c);
+
+    // Частное и остаток могут совпадать с операндами
+    BigNumber y = a;
+    BigNumber d = b;
+    y.DivMod(d, y, d, workspace);
+    assert(y == a / b && d == a % b);
+
+    // Короткий делитель и делимое меньше делителя
+    BigNumber small = fromString("7");
+    a.DivMod(small, q, r, workspace);
+    assert(q == a / small && r == a % small);
+    b.DivMod(a, q, r, workspace);
+    assert(q == fromString("0") && r == b);
+
+    BigNumber32 a32("123456789012345678901234567890123456789012345678901234567890");
+    BigNumber32 b32("98765432109876543210987");
+    auto [quotient32, remainder32] = a32.DivMod(b32);
+    assert(quotient32 * b32 + remainder32 == a32);
+
+    AssertThrowsInvalidArgument([&] { a.DivMod(fromString("0")); });
+
+    std::cout << "[+] TestDivMod PASSED\n";
+}
+
+void TestLimbDivisor()
+{
+    // Шаг 2-на-1 сверяется с аппаратным делением для нормализованных и ненормализованных делителей
+    const std::uint64_t divisors[] = {1, 3, 10, 0x8000000000000000ULL, 0xFFFFFFFFFFFFFFFFULL, 10000000000000000000ULL,
+                                      0x123456789ABCDEFULL};
+    for (std::uint64_t d : divisors)
+    {
+        LimbDivisor divisor(d);
+        std::uint64_t words[] = {0xFFFFFFFFFFFFFFFFULL, 0x0123456789ABCDEFULL, 0, 1, 0x8000000000000000ULL};
+        std::uint64_t quotient[5];
+        std::uint64_t remainder = divisor.Divide(quotient, words, 5);
+
+        unsigned __int128 expectedRemainder = 0;
+        for (int i = 4; i >= 0; --i)
+        {
+            unsigned __int128 current = (expectedRemainder << 64) | words[i];
+            assert(quotient[i] == static_cast<std::uint64_t>(current / d));
+            expectedRemainder = current % d;
+        }
+        assert(remainder == static_cast<std::uint64_t>(expectedRemainder));
+        assert(divisor.Remainder(words, 5) == remainder);
+    }
+
+    // Деление больших чисел на коэффициент и деление Кнута с оценкой 3-на-2
+    BigNumber a = fromString("123456789012345678901234567890123456789012345678901234567890");
+    std::uint64_t remainder = 0;
+    BigNumber quotient = LimbDivisor(1000000007).Divide(a, remainder);
+    assert(quotient * BigNumber(1000000007ULL) + BigNumber(static_cast<unsigned long long>(remainder)) == a);
+    assert(a % 1000000007ULL == BigNumber(static_cast<unsigned long long>(remainder)));
+
+    BigNumber b = fromString("340282366920938463463374607431768211455"); // 2^128 - 1: делитель из единиц
+    BigNumber c = b * b * b + fromString("12345");
+    assert(c / b == b * b && c % b == fromString("12345"));
+
+    BigNumber32 a32("123456789012345678901234567890123456789012345678901234567890");
+    std::uint32_t remainder32 = 0;
+    BigNumber32 quotient32 = LimbDivisor32(10).Divide(a32, remainder32);
+    assert(quotient32 == BigNumber32("12345678901234567890123456789012345678901234567890123456789"));
+    assert(remainder32 == 0);
+
+    AssertThrowsInvalidArgument([&] { LimbDivisor zero(0); });
+
+    std::cout << "[+] TestLimbDivisor PASSED\n";
+}
+
+void TestLimbKernels()
+{
+    // Длины 0..13 покрывают развернутые на четыре коэффициента циклы и их остаток
+    const std::uint64_t max = 0xFFFFFFFFFFFFFFFFULL;
+    for (int n = 0; n < 14; ++n)
+    {
+        std::vector<std::uint64_t> a(n), b(n), r(n), expected(n);
+        for (int i = 0; i < n; ++i)
+        {
+            a[i] = i % 3 == 0 ? max : 0x0123456789ABCDEFULL * (i + 1);
+            b[i] = i % 2 == 0 ? max : 0xFEDCBA9876543210ULL - i;
+        }
+
+        unsigned __int128 carry = 0;
+        for (int i = 0; i < n; ++i)
+        {
+            carry += static_cast<unsigned __int128>(a[i]) + b[i];
+            expected[i] = static_cast<std::uint64_t>(carry);
+            carry >>= 64;
+        }
+        assert(kernels::AddN(r.data(), a.data(), b.data(), n) == static_cast<std::uint64_t>(carry) && r == expected);
+
+        // (a + b) - b = a с тем же переносом в виде заема
+        assert(kernels::SubN(r.data(), r.data(), b.data(), n) == static_cast<std::uint64_t>(carry) && r == a);
+
+        carry = 0;
+        for (int i = 0; i < n; ++i)
+        {
+            carry += static_cast<unsigned __int128>(a[i]) * max;
+            expected[i] = static_cast<std::uint64_t>(carry);
+            carry >>= 64;
+        }
+        assert(kernels::Mul1(r.data(), a.data(), n, max) == static_cast<std::uint64_t>(carry) && r == expected);
+
+        carry = 0;
+        for (int i = 0; i < n; ++i)
+        {
+            carry += static_cast<unsigned __int128>(a[i]) * max + b[i];
+            expected[i] = static_cast<std::uint64_t>(carry);
+            carry >>= 64;
+        }
+        r = b;
+        const std::uint64_t high = kernels::AddMul1(r.data(), a.data(), n, max);
+        assert(high == static_cast<std::uint64_t>(carry) && r == expected);
+
+        // (b + a * max) - a * max = b, заем совпадает со старшим коэффициентом
+        assert(kernels::SubMul1(r.data(), a.data(), n, max) == high && r == b);
+    }
+
+    std::uint32_t a32[] = {0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu};
+    std::uint32_t r32[] = {1, 0, 0};
+    assert(kernels::AddN(r32, r32, a32, 3) == 1 && r32[0] == 0 && r32[1] == 0 && r32[2] == 0);
+    assert(kernels::AddMul1(r32, a32, 3, 0xFFFFFFFFu) == 0xFFFFFFFEu && r32[0] == 1);
+
+    std::cout << "[+] TestLimbKernels PASSED (" << kernels::Implementation() << ")\n";
+}
+
+void TestConstantsAndLiterals()
+{
+    // Значение литерала вычисляется при компиляции
+    constexpr auto maxWord = 18446744073709551615_bn;
+    static_assert(sizeof(maxWord.words) == 2 * sizeof(std::uint64_t) && maxWord.words[0] == ~0ULL, "_bn");
+    constexpr auto hex = 0x1'0000'0000'0000'0001_bn;
+    static_assert(hex.words[0] == 1 && hex.words[1] == 1, "_bn");
+
+    BigNumber a = 123456789012345678901234567890123456789_bn;
+    assert(a == fromString("123456789012345678901234567890123456789"));
+    BigNumber32 a32 = 123456789012345678901234567890123456789_bn;
+    assert(a32 == BigNumber32("123456789012345678901234567890123456789"));
+    assert(BigNumber(0b1010_bn) == BigNumber(10ULL) && BigNumber(017_bn) == BigNumber(15ULL));
+    assert(BigNumber(0_bn).IsZero() && BigNumber32(0_bn).IsZero());
+    assert(a + 1_bn == fromString("123456789012345678901234567890123456790"));
+
+    // Сравнения с коэффициентом
+    const BigNumber five(5ULL);
+    assert(five == 5 && five != 4 && five < 6 && five > 4 && five <= 5 && five >= 5);
+    assert(a > 5 && a != 5 && !(a < 5) && a >= ~0ULL);
+    assert(BigNumber().IsZero() && !five.IsZero() && BigNumber(1_bn).IsOne() && !five.IsOne());
+    assert(five.IsOdd() && !five.IsEven() && (a * 2).IsEven() && BigNumber().IsEven());
+
+    // Деление на степень двойки сдвигом и маской
+    assert(a / 8 == (a >> 3) && a % 8 == BigNumber(static_cast<unsigned long long>(a.TestBit(0) + 2 * a.TestBit(1) +
+                                                                                 4 * a.TestBit(2))));
+    assert(a / 1 == a && a % 1 == 0);
+
+    std::cout << "[+] TestConstantsAndLiterals PASSED\n";
+}
+
+void TestSmallLimbBuffer()
+{
+    using Buffer = SmallLimbBuffer<std::uint64_t, BigNumber::INLINE_LIMBS>;
+    constexpr std::size_t N = BigNumber::INLINE_LIMBS;
+    // Проверяет размер и то, что все коэффициенты равны value
+    auto holds = [](const Buffer &buffer, std::size_t size, std::uint64_t value) {
+        if (buffer.size() != size)
+            return false;
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            if (buffer[i] != value)
+                return false;
+        }
+        return true;
+    };
+
+    // assign и resize на границе встроенного хранилища
+    Buffer buffer;
+    buffer.assign(N, 1);
+    assert(holds(buffer, N, 1) && !buffer.OnHeap() && buffer.capacity() == N);
+    buffer.assign(N + 1, 2);
+    assert(holds(buffer, N + 1, 2) && buffer.OnHeap() && buffer.capacity() >= N + 1);
+    buffer.assign(N - 1, 3);
+    assert(holds(buffer, N - 1, 3) && buffer.OnHeap());
+
+    Buffer resized;
+    resized.resize(N, 4);
+    assert(holds(resized, N, 4) && !resized.OnHeap());
+    resized.resize(N + 1, 4);
+    assert(holds(resized, N + 1, 4) && resized.OnHeap());
+    resized.resize(1);
+    resized.resize(2 * N, 4);
+    assert(holds(resized, 2 * N, 4) && resized[0] == 4);
+
+    Buffer small;
+    small.assign(N, 5);
+    Buffer large;
+    large.assign(N + 1, 6);
+
+    // Копирование: встроенный в вынесенный и вынесенный во встроенный
+    Buffer copy(small);
+    assert(holds(copy, N, 5) && !copy.OnHeap());
+    copy = large;
+    assert(holds(copy, N + 1, 6) && copy.OnHeap() && copy.data() != large.data());
+    Buffer spilled(large);
+    assert(holds(spilled, N + 1, 6) && spilled.OnHeap() && spilled.data() != large.data());
+    spilled = small;
+    assert(holds(spilled, N, 5));
+
+    // Перемещение забирает внешний буфер без копирования и оставляет источник пустым и встроенным
+    const std::uint64_t *heap = large.data();
+    Buffer moved(std::move(large));
+    assert(holds(moved, N + 1, 6) && moved.data() == heap);
+    assert(large.empty() && !large.OnHeap() && large.capacity() == N);
+    Buffer target;
+    target.assign(N, 7);
+    target = std::move(moved);
+    assert(holds(target, N + 1, 6) && target.data() == heap && moved.empty() && !moved.OnHeap());
+    target = std::move(small);
+    assert(holds(target, N, 5) && !target.OnHeap() && small.empty());
+    Buffer inlineMoved(std::move(target));
+    assert(holds(inlineMoved, N, 5) && !inlineMoved.OnHeap() && target.empty());
+
+    // Опустевшие источники снова пригодны для использования
+    large.assign(2 * N, 8);
+    assert(holds(large, 2 * N, 8) && large.OnHeap());
+
+    std::cout << "[+] TestSmallLimbBuffer PASSED\n";
+}
+
+void TestArena()
+{
+    Arena &arena = Arena::ThreadArena();
+    assert(Arena::Current() == nullptr);
+
+    // Внутри области коэффициенты длинных чисел берутся из арены, после нее — снова из кучи
+    const BigNumber a = (BigNumber(1_bn) << 4000) - 1_bn;
+    BigNumber result;
+    {
+        ArenaScope scope;
+        assert(Arena::Current() == &arena);
+        BigNumber square = a * a;
+        assert(arena.Stats().allocations > 0 && arena.Owns(square.GetCoefficients()));
+        {
+            HeapScope heap;
+            result = square;
+            assert(Arena::Current() == nullptr);
+        }
+        assert(!arena.Owns(result.GetCoefficients()));
+    }
+    assert(Arena::Current() == nullptr && result == a * a);
+
+    // Полный тест простоты после первого прохода не запрашивает у кучи новых блоков
+    const BigNumber prime = (BigNumber(1_bn) << 1279) - 1_bn;
+    BigNumber copy = prime;
+    assert(copy.MillerRabinTest(4));
+    arena.ResetStats();
+    for (int i = 0; i < 4; ++i)
+    {
+        assert(copy.MillerRabinTest(4) && copy.FermatTest(4));
+        assert(!BigNumber(prime * 3_bn).MillerRabinTest(4));
+    }
+    const ArenaStats stats = arena.Stats();
+    assert(stats.heapBlocks == 0 && stats.allocations > 0 && stats.rewinds >= 32);
+    assert(stats.peakBytes <= stats.bytesReserved);
+
+    std::cout << "[+] TestArena PASSED\n";
+}
+
+template <typename Number> void CheckGenericAlgorithms()
+{
+    // Символ Якоби: (2/15) = 1, (7/15) = -1, (5/15) = 0, (1001/9907) = -1
+    assert(generic::Jacobi(Number(2ULL), Number(15ULL)) == 1 && generic::Jacobi(Number(7ULL), Number(15ULL)) == -1);
+    assert(generic::Jacobi(Number(5ULL), Number(15ULL)) == 0 && generic::Jacobi(Number(1001ULL), Number(9907ULL)) == -1);
+
+    const Number mersenne = Number("170141183460469231731687303715884105727"); // 2^127 - 1
+    const Number base = Number("123456789123456789");
+    assert(generic::PowMod(base, mersenne - Number(1ULL), mersenne) == Number(1ULL));
+    assert(generic::PowMod(base, Number(0ULL), Number(1ULL)).IsZero());
+
+    // Простые и числа Кармайкла, которые проходят тест Ферма для взаимно простых оснований
+    assert(generic::MillerRabinTest(mersenne, 20) && generic::SoloveyStrassenTest(mersenne, 20));
+    assert(generic::FermatTest(Number(65537ULL), 20) && generic::LucasTest(Number(65537ULL), 20));
+    for (unsigned long long carmichael : {561ULL, 41041ULL, 825265ULL, 321197185ULL})
+    {
+        assert(!generic::MillerRabinTest(Number(carmichael), 20));
+        assert(!generic::SoloveyStrassenTest(Number(carmichael), 20));
+    }
+    assert(!generic::LucasTest(Number(561ULL), 20));
+
+    const Number prime = generic::GenerateRandomPrime<Number>(160, 20);
+    assert(prime.BitLength() == 160 && generic::MillerRabinTest(prime, 20));
+}
+
+void TestGenericAlgorithms()
+{
+    CheckGenericAlgorithms<BigNumber>();
+    CheckGenericAlgorithms<BigNumber32>();
+    std::cout << "[+] TestGenericAlgorithms PASSED\n";
+}
+
+template <typename Number> void CheckGenerator()
+{
+    // Малый диапазон: все значения попадают в [10, 15] и встречаются примерно одинаково часто
+    const Number low(10ULL), high(15ULL);
+    int counts[6] = {};
+    for (int i = 0; i < 6000; ++i)
+    {
+        Number value = Number::Generator(0, low, high);
+        assert(value >= low && value <= high);
+        ++counts[value.GetCoefficients()[0] - 10];
+    }
+    for (int count : counts)
+        assert(count > 800 && count < 1200);
+
+    // Диапазон, граница которого лежит на стыке коэффициентов
+    const Number one(1ULL);
+    const Number start = (Number(one) << 100) + Number(12345ULL);
+    const Number end = start + (Number(one) << 64) - one;
+    for (int i = 0; i < 200; ++i)
+    {
+        const Number value = Number::Generator(0, start, end);
+        assert(value >= start && value <= end);
+    }
+    assert(Number::Generator(0, start, start) == start);
+
+    AssertThrowsInvalidArgument([&] { Number::Generator(0, high, low); });
+}
+
+void TestGenerator()
+{
+    CheckGenerator<BigNumber>();
+    CheckGenerator<BigNumber32>();
+
+    // Одинаковое зерно дает одинаковую последовательность
+    const BigNumber high = (BigNumber(1_bn) << 1000) - 1_bn;
+    RandomEngine::ThreadEngine().Seed(42);
+    const BigNumber first = BigNumber::Generator(0, 0_bn, high);
+    RandomEngine::ThreadEngine().Seed(42);
+    assert(BigNumber::Generator(0, 0_bn, high) == first);
+
+    std::cout << "[+] TestGenerator PASSED\n";
+}
+
+template <typename Number> void CheckSerialization()
+{
+    using View = BasicBigNumberView<typename Number::BaseType>;
+    const Number one(1ULL);
+    const Number a = (Number(one) << 200) + Number("123456789012345678901234567890");
+    const Number m = (Number(one) << 127) - one;
+    const Number even = Number(m) + one;
+
+    // Запись: число слов и слова little-endian, одинаковые для обоих типов коэффициентов
+    const std::vector<unsigned char> bytes = a.Serialize();
+    assert(bytes.size() == a.SerializedSize() && bytes.size() == 8 * (1 + 4) && bytes[0] == 4);
+    const std::string decimal = "1606938044258990275541962092341286059311215339461694069869266";
+    assert(BigNumber(decimal).Serialize() == bytes && BigNumber32(decimal).Serialize() == bytes);
+    std::size_t consumed = 0;
+    assert(Number::Deserialize(bytes.data(), bytes.size(), &consumed) == a && consumed == bytes.size());
+    assert(Number().Serialize().size() == 8 && Number::Deserialize(Number().Serialize().data(), 8).IsZero());
+
+    AssertThrowsInvalidArgument([&] { Number::Deserialize(bytes.data(), bytes.size() - 1); });
+
+    // Представление записи указывает прямо на слова буфера
+    std::vector<std::uint64_t> storage((a.SerializedSize() + 7) / 8);
+    const unsigned char *buffer = reinterpret_cast<const unsigned char *>(storage.data());
+    a.Serialize(reinterpret_cast<unsigned char *>(storage.data()));
+    const View view = View::FromSerialized(buffer, a.SerializedSize(), &consumed);
+    assert(view.Data() == reinterpret_cast<const typename Number::BaseType *>(storage.data() + 1));
+    assert(consumed == a.SerializedSize() && view.ToNumber() == a && view.BitLength() == a.BitLength());
+
+    // Сравнения принимают представления и числа с любой стороны
+    assert(view == a && a == view && view != m && m < view && view > m && view <= a && a >= view);
+    assert(View() == Number() && View() < view && View().IsZero() && View(one).IsOne());
+
+    // Возведение в степень и символ Якоби над представлениями совпадают с обычными
+    const View exponent(m);
+    assert(Number::ModularExponentiation(view, exponent, m) == a.ModularExponentiation(m, m));
+    assert(Number::ModularExponentiation(view, exponent, even) == a.ModularExponentiation(m, even));
+    assert(Number::ModularExponentiation(view, View(), m).IsOne());
+    assert(generic::Jacobi(view, View(m)) == generic::Jacobi(a, m));
+}
+
+void TestSerialization()
+{
+    CheckSerialization<BigNumber>();
+    CheckSerialization<BigNumber32>();
+    std::cout << "[+] TestSerialization PASSED\n";
+}
+
 void stressTest()
 {
     // Количество итераций – можно увеличить для более сильного стресса
@@ -233,8 +966,10 @@ void FastSquareTest()
     big_number::BigNumber BN;
     std::cin >> BN;
 
+    // Умножение на копию, чтобы operator* не выбрал путь возведения в квадрат
+    big_number::BigNumber copy = BN;
     auto start_multiply = std::chrono::high_resolution_clock::now();
-    auto multiply = BN * BN;
+    auto multiply = BN * copy;
     auto end_multiply = std::chrono::high_resolution_clock::now();
     std::chrono::duration<double> duration_multiply = end_multiply - start_multiply;
 